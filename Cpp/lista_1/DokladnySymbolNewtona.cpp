@@ -0,0 +1,163 @@
+#include "DokladnySymbolNewtona.h"
+#include "PulaWatkow.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+// Liczby w segmencie sita; 256 KB mieści się w pamięci podręcznej L2 jednego rdzenia.
+static const long long ROZMIAR_SEGMENTU = 1 << 18;
+
+// Liczby pierwsze do n prostym sitem; wołane tylko dla n ~ pierwiastek z wiersza.
+static vector<uint32_t> liczbyPierwsze(long long n) {
+    vector<uint32_t> pierwsze;
+    if (n < 2) {
+        return pierwsze;
+    }
+    vector<char> zlozona(n + 1, 0);
+    for (long long i = 2; i <= n; ++i) {
+        if (zlozona[i]) {
+            continue;
+        }
+        pierwsze.push_back((uint32_t) i);
+        for (long long j = i * i; j <= n; j += i) {
+            zlozona[j] = 1;
+        }
+    }
+    return pierwsze;
+}
+
+static long long pierwiastek(long long n) {
+    long long r = (long long) sqrt((double) n);
+    while (r * r > n) {
+        --r;
+    }
+    while ((r + 1) * (r + 1) <= n) {
+        ++r;
+    }
+    return r;
+}
+
+// Potęgi liczb pierwszych z [od, doLiczby) w rozkładzie C(n, k), spakowane do słów 64-bitowych,
+// póki się mieszczą. bazowe to wszystkie liczby pierwsze do pierwiastka z n.
+static vector<uint64_t> czynnikiSegmentu(long long n, long long k, const vector<uint32_t>& bazowe,
+                                         long long od, long long doLiczby) {
+    static thread_local vector<char> zlozona;
+    zlozona.assign(doLiczby - od, 0);
+    for (uint32_t p : bazowe) {
+        long long kwadrat = (long long) p * p;
+        if (kwadrat >= doLiczby) {
+            break;
+        }
+        for (long long j = max(kwadrat, (od + p - 1) / p * p); j < doLiczby; j += p) {
+            zlozona[j - od] = 1;
+        }
+    }
+
+    vector<uint64_t> czynniki;
+    uint64_t slowo = 1;
+    for (long long p = od; p < doLiczby; ++p) {
+        if (zlozona[p - od]) {
+            continue;
+        }
+        for (int e = DokladnySymbolNewtona::wykladnik(n, k, p); e > 0; --e) {
+            uint64_t iloczyn;
+            if (__builtin_mul_overflow(slowo, (uint64_t) p, &iloczyn)) {
+                czynniki.push_back(slowo);
+                slowo = p;
+            } else {
+                slowo = iloczyn;
+            }
+        }
+    }
+    if (slowo > 1) {
+        czynniki.push_back(slowo);
+    }
+    return czynniki;
+}
+
+// Iloczyn czynniki[od..do) parami, żeby mnożone liczby miały zbliżone długości.
+static DuzaLiczba iloczynDrzewem(const vector<uint64_t>& czynniki, size_t od, size_t doIndeksu) {
+    if (doIndeksu - od == 0) {
+        return DuzaLiczba(1);
+    }
+    if (doIndeksu - od == 1) {
+        return DuzaLiczba(czynniki[od]);
+    }
+    size_t srodek = od + (doIndeksu - od) / 2;
+    return DuzaLiczba::iloczyn(iloczynDrzewem(czynniki, od, srodek), iloczynDrzewem(czynniki, srodek, doIndeksu));
+}
+
+int DokladnySymbolNewtona::wykladnik(long long n, long long k, long long p) {
+    int e = 0;
+    for (long long q = p; q <= n; q *= p) {
+        e += n / q - k / q - (n - k) / q;
+        if (q > n / p) {
+            break;
+        }
+    }
+    return e;
+}
+
+DuzaLiczba DokladnySymbolNewtona::oblicz(long long n, long long k, int liczbaWatkow) {
+    if (n < 0) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    if (k < 0 || k > n) {
+        throw out_of_range(to_string(k) + " - liczba spoza zakresu");
+    }
+    k = min(k, n - k);
+    if (k == 0) {
+        return DuzaLiczba(1);
+    }
+
+    // Sito segmentami od 2 do n: segmenty rozdaje pula, a każdy od razu zamienia swoje liczby
+    // pierwsze na potęgi ze wzoru Legendre'a, więc sito zajmuje jeden segment na wątek zamiast n bajtów.
+    PulaWatkow pula(max(liczbaWatkow, 1));
+    vector<uint32_t> bazowe = liczbyPierwsze(pierwiastek(n));
+    long long liczbaSegmentow = (n - 1 + ROZMIAR_SEGMENTU - 1) / ROZMIAR_SEGMENTU;
+    vector<vector<uint64_t>> segmenty(liczbaSegmentow);
+    for (long long s = 0; s < liczbaSegmentow; ++s) {
+        long long od = 2 + s * ROZMIAR_SEGMENTU;
+        long long doLiczby = min(od + ROZMIAR_SEGMENTU, n + 1);
+        pula.dodaj([&segmenty, &bazowe, n, k, s, od, doLiczby] {
+            segmenty[s] = czynnikiSegmentu(n, k, bazowe, od, doLiczby);
+        });
+    }
+    pula.czekaj();
+
+    vector<uint64_t> czynniki;
+    for (vector<uint64_t>& segment : segmenty) {
+        czynniki.insert(czynniki.end(), segment.begin(), segment.end());
+    }
+    segmenty.clear();
+
+    size_t liczbaCzesci = min((size_t) max(liczbaWatkow, 1), max(czynniki.size(), (size_t) 1));
+    vector<DuzaLiczba> czesci(liczbaCzesci);
+    for (size_t i = 0; i < liczbaCzesci; ++i) {
+        size_t od = czynniki.size() * i / liczbaCzesci;
+        size_t doIndeksu = czynniki.size() * (i + 1) / liczbaCzesci;
+        pula.dodaj([&czynniki, &czesci, i, od, doIndeksu] {
+            czesci[i] = iloczynDrzewem(czynniki, od, doIndeksu);
+        });
+    }
+    pula.czekaj();
+
+    // Górne poziomy drzewa też równolegle: w każdej rundzie mnożymy sąsiednie pary.
+    while (czesci.size() > 1) {
+        vector<DuzaLiczba> nastepne((czesci.size() + 1) / 2);
+        for (size_t i = 0; i < nastepne.size(); ++i) {
+            pula.dodaj([&czesci, &nastepne, i] {
+                if (2 * i + 1 < czesci.size()) {
+                    nastepne[i] = DuzaLiczba::iloczyn(czesci[2 * i], czesci[2 * i + 1]);
+                } else {
+                    nastepne[i] = std::move(czesci[2 * i]);
+                }
+            });
+        }
+        pula.czekaj();
+        czesci = std::move(nastepne);
+    }
+    return std::move(czesci[0]);
+}
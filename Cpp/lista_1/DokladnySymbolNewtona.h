@@ -0,0 +1,15 @@
+#ifndef DOKLADNYSYMBOLNEWTONA_H
+#define DOKLADNYSYMBOLNEWTONA_H
+
+#include "DuzaLiczba.h"
+
+// Dokładne C(n, k) bez wiersza: sito segmentami do n, wykładnik każdej liczby pierwszej ze wzoru
+// Legendre'a, a potem iloczyn potęg liczony drzewem iloczynów (Karatsuba).
+// Segmenty sita i poddrzewa iloczynu dzielone są między wątki puli.
+class DokladnySymbolNewtona {
+public:
+    static DuzaLiczba oblicz(long long n, long long k, int liczbaWatkow);
+    static int wykladnik(long long n, long long k, long long p);
+};
+
+#endif
@@ -0,0 +1,384 @@
+#include "DuzaLiczba.h"
+#include "PulaWierszy.h"
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+DuzaLiczba::DuzaLiczba(unsigned long long wartosc) {
+    limby.push_back(wartosc);
+}
+
+DuzaLiczba::DuzaLiczba(const uint64_t* limby, int dlugosc) : limby(limby, limby + dlugosc) {
+    if (this->limby.empty()) {
+        this->limby.push_back(0);
+    }
+}
+
+string DuzaLiczba::naNapis() const {
+    return naNapis(limby.data(), (int) limby.size());
+}
+
+string naNapis(const DuzaLiczba& liczba) {
+    return liczba.naNapis();
+}
+
+void DuzaLiczba::pomnoz(uint64_t czynnik) {
+    uint64_t przeniesienie = 0;
+    for (uint64_t& limb : limby) {
+        unsigned __int128 iloczyn = (unsigned __int128) limb * czynnik + przeniesienie;
+        limb = (uint64_t) iloczyn;
+        przeniesienie = (uint64_t) (iloczyn >> 64);
+    }
+    if (przeniesienie) {
+        limby.push_back(przeniesienie);
+    }
+}
+
+// Zwraca resztę; najstarsze zerowe limby są obcinane, ale zawsze zostaje co najmniej jeden.
+uint64_t DuzaLiczba::podziel(uint64_t dzielnik) {
+    unsigned __int128 reszta = 0;
+    for (int j = (int) limby.size() - 1; j >= 0; --j) {
+        unsigned __int128 akumulator = (reszta << 64) | limby[j];
+        limby[j] = (uint64_t) (akumulator / dzielnik);
+        reszta = akumulator % dzielnik;
+    }
+    while (limby.size() > 1 && limby.back() == 0) {
+        limby.pop_back();
+    }
+    return (uint64_t) reszta;
+}
+
+static const int PROG_KARATSUBY = 32;
+
+static void mnozSzkolnie(const uint64_t* a, int na, const uint64_t* b, int nb, uint64_t* wynik) {
+    fill(wynik, wynik + na + nb, 0);
+    for (int i = 0; i < na; ++i) {
+        uint64_t przeniesienie = 0;
+        for (int j = 0; j < nb; ++j) {
+            unsigned __int128 t = (unsigned __int128) a[i] * b[j] + wynik[i + j] + przeniesienie;
+            wynik[i + j] = (uint64_t) t;
+            przeniesienie = (uint64_t) (t >> 64);
+        }
+        wynik[i + nb] = przeniesienie;
+    }
+}
+
+// a[0..na) += b[0..nb) dla na >= nb; zwraca przeniesienie z najstarszego limbu.
+static uint64_t dodajDo(uint64_t* a, int na, const uint64_t* b, int nb) {
+    uint64_t przeniesienie = 0;
+    for (int j = 0; j < na && (j < nb || przeniesienie); ++j) {
+        unsigned __int128 t = (unsigned __int128) a[j] + (j < nb ? b[j] : 0) + przeniesienie;
+        a[j] = (uint64_t) t;
+        przeniesienie = (uint64_t) (t >> 64);
+    }
+    return przeniesienie;
+}
+
+// a[0..na) -= b[0..nb) dla a >= b.
+static void odejmijOd(uint64_t* a, int na, const uint64_t* b, int nb) {
+    uint64_t pozyczka = 0;
+    for (int j = 0; j < na && (j < nb || pozyczka); ++j) {
+        uint64_t odjemnik = j < nb ? b[j] : 0;
+        uint64_t roznica = a[j] - odjemnik - pozyczka;
+        pozyczka = a[j] < odjemnik || (a[j] == odjemnik && pozyczka);
+        a[j] = roznica;
+    }
+}
+
+// Karatsuba powyżej PROG_KARATSUBY limbów; wynik ma dokładnie na + nb limbów.
+static vector<uint64_t> mnoz(const uint64_t* a, int na, const uint64_t* b, int nb) {
+    if (na < nb) {
+        swap(a, b);
+        swap(na, nb);
+    }
+    vector<uint64_t> wynik(na + nb);
+    if (nb < PROG_KARATSUBY) {
+        mnozSzkolnie(a, na, b, nb, wynik.data());
+        return wynik;
+    }
+
+    int m = na / 2;
+    if (nb <= m) {
+        // Nierówne długości: a dzielimy na kawałki długości nb.
+        for (int start = 0; start < na; start += nb) {
+            int dlugosc = min(nb, na - start);
+            vector<uint64_t> czesc = mnoz(a + start, dlugosc, b, nb);
+            dodajDo(wynik.data() + start, na + nb - start, czesc.data(), dlugosc + nb);
+        }
+        return wynik;
+    }
+
+    vector<uint64_t> z0 = mnoz(a, m, b, m);
+    vector<uint64_t> z2 = mnoz(a + m, na - m, b + m, nb - m);
+
+    vector<uint64_t> sumaA(a + m, a + na);
+    sumaA.push_back(0);
+    dodajDo(sumaA.data(), (int) sumaA.size(), a, m);
+    vector<uint64_t> sumaB(max(m, nb - m) + 1, 0);
+    copy(b + m, b + nb, sumaB.begin());
+    dodajDo(sumaB.data(), (int) sumaB.size(), b, m);
+
+    vector<uint64_t> z1 = mnoz(sumaA.data(), (int) sumaA.size(), sumaB.data(), (int) sumaB.size());
+    odejmijOd(z1.data(), (int) z1.size(), z0.data(), (int) z0.size());
+    odejmijOd(z1.data(), (int) z1.size(), z2.data(), (int) z2.size());
+
+    copy(z0.begin(), z0.end(), wynik.begin());
+    dodajDo(wynik.data() + 2 * m, na + nb - 2 * m, z2.data(), na + nb - 2 * m);
+    int dlugoscZ1 = min((int) z1.size(), na + nb - m);
+    dodajDo(wynik.data() + m, na + nb - m, z1.data(), dlugoscZ1);
+    return wynik;
+}
+
+DuzaLiczba DuzaLiczba::iloczyn(const DuzaLiczba& a, const DuzaLiczba& b) {
+    DuzaLiczba wynik;
+    wynik.limby = mnoz(a.limby.data(), (int) a.limby.size(), b.limby.data(), (int) b.limby.size());
+    while (wynik.limby.size() > 1 && wynik.limby.back() == 0) {
+        wynik.limby.pop_back();
+    }
+    return wynik;
+}
+
+// Dzielimy kopię przez 10^19, każda reszta to 19 cyfr dziesiętnych od końca.
+string DuzaLiczba::naNapis(const uint64_t* limby, int dlugosc) {
+    string napis(maksCyfr(dlugosc), '\0');
+    napis.resize(zapiszCyfry(limby, dlugosc, napis.data()));
+    return napis;
+}
+
+// Bufory robocze są wspólne dla wywołań w wątku, więc wypisanie wiersza nie alokuje na każdy element.
+size_t DuzaLiczba::zapiszCyfry(const uint64_t* limby, int dlugosc, char* cel) {
+    thread_local vector<uint64_t> reszta;
+    thread_local vector<uint64_t> grupy;
+    reszta.assign(limby, limby + dlugosc);
+    while (!reszta.empty() && reszta.back() == 0) {
+        reszta.pop_back();
+    }
+    if (reszta.empty()) {
+        cel[0] = '0';
+        return 1;
+    }
+
+    grupy.clear();
+    while (!reszta.empty()) {
+        unsigned __int128 r = 0;
+        for (int j = (int) reszta.size() - 1; j >= 0; --j) {
+            unsigned __int128 akumulator = (r << 64) | reszta[j];
+            reszta[j] = (uint64_t) (akumulator / DZIESIEC_DO_19);
+            r = akumulator % DZIESIEC_DO_19;
+        }
+        grupy.push_back((uint64_t) r);
+        while (!reszta.empty() && reszta.back() == 0) {
+            reszta.pop_back();
+        }
+    }
+
+    char* koniec = to_chars(cel, cel + 20, grupy.back()).ptr;
+    for (int j = (int) grupy.size() - 2; j >= 0; --j) {
+        uint64_t grupa = grupy[j];
+        for (int c = 18; c >= 0; --c) {
+            koniec[c] = char('0' + grupa % 10);
+            grupa /= 10;
+        }
+        koniec += 19;
+    }
+    return koniec - cel;
+}
+
+WierszTrojkataPascala<DuzaLiczba>::WierszTrojkataPascala(int n, Przechowywanie przechowywanie, bool)
+    : przechowywanie(przechowywanie) {
+    przygotuj(n, 0);
+    obliczenieNtegoWiersza(n);
+}
+
+WierszTrojkataPascala<DuzaLiczba>::WierszTrojkataPascala(const WierszTrojkataPascala& poprzedni, int n, bool)
+    : przechowywanie(poprzedni.przechowywanie) {
+    przygotuj(n, poprzedni.size - 1);
+    for (int i = 0; i < poprzedni.przechowywane; ++i) {
+        copy_n(poprzedni.arena + (size_t) i * poprzedni.szerokosc, poprzedni.dlugosci[i], arena + (size_t) i * szerokosc);
+        dlugosci[i] = poprzedni.dlugosci[i];
+    }
+    przesunWiersz(poprzedni.size - 1, n);
+}
+
+WierszTrojkataPascala<DuzaLiczba>::WierszTrojkataPascala(const WierszTrojkataPascala<unsigned __int128>& wezszy,
+                                                         int n, bool)
+    : przechowywanie(wezszy.przechowywanie) {
+    przygotuj(n, wezszy.size - 1);
+    for (int i = 0; i < wezszy.przechowywane; ++i) {
+        unsigned __int128 wartosc = wezszy.tablica[i];
+        arena[(size_t) i * szerokosc] = (uint64_t) wartosc;
+        dlugosci[i] = 1;
+        if (wartosc >> 64) {
+            arena[(size_t) i * szerokosc + 1] = (uint64_t) (wartosc >> 64);
+            dlugosci[i] = 2;
+        }
+    }
+    przesunWiersz(wezszy.size - 1, n);
+}
+
+// Wspólny początek konstruktorów: sprawdza, że n nie jest przed wierszem odWiersza,
+// i przydziela wyzerowaną arenę. C(n, k) < 2^n, więc n / 64 + 1 limbów wystarcza dla każdego elementu.
+void WierszTrojkataPascala<DuzaLiczba>::przygotuj(int n, int odWiersza) {
+    if (n < odWiersza) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    size = n + 1;
+    przechowywane = przechowywanie == Przechowywanie::polowa ? n / 2 + 1 : size;
+    szerokosc = n / 64 + 1;
+    arena = PulaWierszy::przydziel<uint64_t>((size_t) przechowywane * szerokosc);
+    fill_n(arena, (size_t) przechowywane * szerokosc, 0);
+    dlugosci = PulaWierszy::przydziel<int>(przechowywane);
+}
+
+WierszTrojkataPascala<DuzaLiczba>::WierszTrojkataPascala(WierszTrojkataPascala&& inny) noexcept
+    : arena(exchange(inny.arena, nullptr)), dlugosci(exchange(inny.dlugosci, nullptr)),
+      szerokosc(exchange(inny.szerokosc, 0)), size(exchange(inny.size, 0)),
+      przechowywane(exchange(inny.przechowywane, 0)), przechowywanie(inny.przechowywanie),
+      sumy(exchange(inny.sumy, nullptr)), dlugosciSum(exchange(inny.dlugosciSum, nullptr)) {}
+
+WierszTrojkataPascala<DuzaLiczba>& WierszTrojkataPascala<DuzaLiczba>::operator=(WierszTrojkataPascala&& inny) noexcept {
+    if (this != &inny) {
+        zwolnij();
+        arena = exchange(inny.arena, nullptr);
+        dlugosci = exchange(inny.dlugosci, nullptr);
+        szerokosc = exchange(inny.szerokosc, 0);
+        size = exchange(inny.size, 0);
+        przechowywane = exchange(inny.przechowywane, 0);
+        przechowywanie = inny.przechowywanie;
+        sumy = exchange(inny.sumy, nullptr);
+        dlugosciSum = exchange(inny.dlugosciSum, nullptr);
+    }
+    return *this;
+}
+
+WierszTrojkataPascala<DuzaLiczba>::~WierszTrojkataPascala() {
+    zwolnij();
+}
+
+void WierszTrojkataPascala<DuzaLiczba>::zwolnij() {
+    PulaWierszy::zwolnij(arena);
+    PulaWierszy::zwolnij(dlugosci);
+    PulaWierszy::zwolnij(sumy);
+    PulaWierszy::zwolnij(dlugosciSum);
+}
+
+int WierszTrojkataPascala<DuzaLiczba>::indeks(int m) {
+    if (m < 0 || m >= size) {
+        throw out_of_range(to_string(m) + " - liczba spoza zakresu");
+    }
+    return m < przechowywane ? m : size - 1 - m;
+}
+
+span<const uint64_t> WierszTrojkataPascala<DuzaLiczba>::widokElementu(int m) {
+    int i = indeks(m);
+    return span<const uint64_t>(arena + (size_t) i * szerokosc, dlugosci[i]);
+}
+
+DuzaLiczba WierszTrojkataPascala<DuzaLiczba>::MtyElementWiersza(int m) {
+    int i = indeks(m);
+    return DuzaLiczba(arena + (size_t) i * szerokosc, dlugosci[i]);
+}
+
+size_t WierszTrojkataPascala<DuzaLiczba>::zajetaPamiec() const {
+    size_t bajty = sizeof(uint64_t) * przechowywane * szerokosc + sizeof(int) * przechowywane;
+    if (sumy) {
+        bajty += (sizeof(uint64_t) * szerokosc + sizeof(int)) * (size + 1);
+    }
+    return bajty;
+}
+
+string WierszTrojkataPascala<DuzaLiczba>::napisElementu(int m) {
+    int i = indeks(m);
+    return DuzaLiczba::naNapis(arena + (size_t) i * szerokosc, dlugosci[i]);
+}
+
+void WierszTrojkataPascala<DuzaLiczba>::zbudujSumy() {
+    sumy = PulaWierszy::przydziel<uint64_t>((size_t) (size + 1) * szerokosc);
+    fill_n(sumy, (size_t) (size + 1) * szerokosc, 0);
+    dlugosciSum = PulaWierszy::przydziel<int>(size + 1);
+    dlugosciSum[0] = 1;
+    for (int k = 0; k < size; ++k) {
+        uint64_t* cel = sumy + (size_t) (k + 1) * szerokosc;
+        int i = indeks(k);
+        copy_n(sumy + (size_t) k * szerokosc, dlugosciSum[k], cel);
+        int dlugosc = min(max(dlugosciSum[k], dlugosci[i]) + 1, szerokosc);
+        dodajDo(cel, dlugosc, arena + (size_t) i * szerokosc, dlugosci[i]);
+        while (dlugosc > 1 && cel[dlugosc - 1] == 0) {
+            --dlugosc;
+        }
+        dlugosciSum[k + 1] = dlugosc;
+    }
+}
+
+DuzaLiczba WierszTrojkataPascala<DuzaLiczba>::sumaZakresu(int a, int b) {
+    indeks(a);
+    indeks(b);
+    if (a > b) {
+        throw invalid_argument(to_string(a) + ".." + to_string(b) + " - nieprawidłowy zakres");
+    }
+    if (!sumy) {
+        zbudujSumy();
+    }
+    DuzaLiczba wynik(sumy + (size_t) (b + 1) * szerokosc, dlugosciSum[b + 1]);
+    odejmijOd(wynik.limby.data(), (int) wynik.limby.size(), sumy + (size_t) a * szerokosc, dlugosciSum[a]);
+    while (wynik.limby.size() > 1 && wynik.limby.back() == 0) {
+        wynik.limby.pop_back();
+    }
+    return wynik;
+}
+
+string WierszTrojkataPascala<DuzaLiczba>::napisSumy(int a, int b) {
+    return sumaZakresu(a, b).naNapis();
+}
+
+void WierszTrojkataPascala<DuzaLiczba>::obliczenieNtegoWiersza(int n) {
+    arena[0] = 1;
+    dlugosci[0] = 1;
+    przesunWiersz(0, n);
+}
+
+// Ten sam schemat co w WierszTrojkataPascala: wiersz r w miejscu wiersza r-1, od prawej.
+void WierszTrojkataPascala<DuzaLiczba>::przesunWiersz(int z, int n) {
+    for (int r = z + 1; r <= n; ++r) {
+        int k = r;
+        if (przechowywanie == Przechowywanie::caly) {
+            arena[(size_t) r * szerokosc] = 1;
+            dlugosci[r] = 1;
+        } else {
+            int h = r / 2 + 1;
+            k = h;
+            if (r % 2 == 0) {
+                copy_n(arena + (size_t) (h - 2) * szerokosc, dlugosci[h - 2], arena + (size_t) (h - 1) * szerokosc);
+                dlugosci[h - 1] = dlugosci[h - 2];
+                dodajElement(h - 1, h - 2);
+                k = h - 1;
+            }
+        }
+        for (int i = k - 1; i > 0; --i) {
+            dodajElement(i, i - 1);
+        }
+    }
+}
+
+// Limby ponad dlugosci[i] są zerami, więc dodajemy bez rozróżniania krótszego składnika.
+void WierszTrojkataPascala<DuzaLiczba>::dodajElement(int i, int zrodlo) {
+    uint64_t* cel = arena + (size_t) i * szerokosc;
+    const uint64_t* skladnik = arena + (size_t) zrodlo * szerokosc;
+    int dlugosc = max(dlugosci[i], dlugosci[zrodlo]);
+    uint64_t przeniesienie = 0;
+    for (int j = 0; j < dlugosc; ++j) {
+        uint64_t suma = cel[j] + skladnik[j];
+        uint64_t nowePrzeniesienie = suma < cel[j];
+        suma += przeniesienie;
+        nowePrzeniesienie |= suma < przeniesienie;
+        cel[j] = suma;
+        przeniesienie = nowePrzeniesienie;
+    }
+    if (przeniesienie) {
+        cel[dlugosc++] = 1;
+    }
+    dlugosci[i] = dlugosc;
+}
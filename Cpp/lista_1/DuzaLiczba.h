@@ -0,0 +1,74 @@
+#ifndef DUZALICZBA_H
+#define DUZALICZBA_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include "WierszTrojkataPascala.h"
+
+class DuzaLiczba {
+public:
+    DuzaLiczba(unsigned long long wartosc = 0);
+    DuzaLiczba(const uint64_t* limby, int dlugosc);
+    std::string naNapis() const;
+    static std::string naNapis(const uint64_t* limby, int dlugosc);
+    // Cyfry dziesiętne do cel, który ma co najmniej maksCyfr(dlugosc) bajtów; zwraca liczbę cyfr.
+    static size_t zapiszCyfry(const uint64_t* limby, int dlugosc, char* cel);
+    static size_t maksCyfr(int dlugosc) { return (size_t) dlugosc * 20 + 1; }
+    // Największa potęga dziesięciu w 64 bitach; cyfry wypisujemy grupami po 19.
+    static constexpr uint64_t DZIESIEC_DO_19 = 10000000000000000000ULL;
+    void pomnoz(uint64_t czynnik);
+    uint64_t podziel(uint64_t dzielnik);
+    static DuzaLiczba iloczyn(const DuzaLiczba& a, const DuzaLiczba& b);
+    std::vector<uint64_t> limby;
+};
+
+std::string naNapis(const DuzaLiczba& liczba);
+
+// Wiersz liczony dokładnie. Wszystkie elementy leżą w jednej arenie,
+// element i zajmuje limby [i * szerokosc, i * szerokosc + dlugosci[i]).
+// W trybie polowa arena ma tylko przechowywane = n/2 + 1 elementów.
+template <>
+class WierszTrojkataPascala<DuzaLiczba> {
+public:
+    // DuzaLiczba się nie przepełnia, więc doPrzepelnienia jest tu tylko dla zgodności z typami stałej szerokości.
+    explicit WierszTrojkataPascala(int n, Przechowywanie przechowywanie = Przechowywanie::caly,
+                                   bool doPrzepelnienia = false);
+    WierszTrojkataPascala(const WierszTrojkataPascala& poprzedni, int n, bool doPrzepelnienia = false);
+    // Promocja z wiersza unsigned __int128.
+    WierszTrojkataPascala(const WierszTrojkataPascala<unsigned __int128>& wezszy, int n, bool doPrzepelnienia = false);
+    WierszTrojkataPascala(const WierszTrojkataPascala&) = delete;
+    WierszTrojkataPascala& operator=(const WierszTrojkataPascala&) = delete;
+    WierszTrojkataPascala(WierszTrojkataPascala&& inny) noexcept;
+    WierszTrojkataPascala& operator=(WierszTrojkataPascala&& inny) noexcept;
+    ~WierszTrojkataPascala();
+    // Limby elementu m prosto z areny, bez kopiowania.
+    std::span<const uint64_t> widokElementu(int m);
+    DuzaLiczba MtyElementWiersza(int m);
+    std::string napisElementu(int m);
+    DuzaLiczba sumaZakresu(int a, int b);
+    std::string napisSumy(int a, int b);
+    size_t zajetaPamiec() const;
+    uint64_t* arena = nullptr;
+    int* dlugosci = nullptr;
+    int szerokosc;
+    int size;
+    int przechowywane;
+    Przechowywanie przechowywanie;
+    // Sumy prefiksowe w drugiej arenie o tej samej szerokości (suma wiersza to 2^n < 2^(64 * szerokosc)),
+    // budowane przy pierwszym sumaZakresu.
+    uint64_t* sumy = nullptr;
+    int* dlugosciSum = nullptr;
+
+private:
+    void przygotuj(int n, int odWiersza);
+    void obliczenieNtegoWiersza(int n);
+    void zbudujSumy();
+    void zwolnij();
+    void przesunWiersz(int z, int n);
+    void dodajElement(int i, int zrodlo);
+    int indeks(int m);
+};
+
+#endif
@@ -0,0 +1,139 @@
+#include "FormatBinarny.h"
+#include "DuzaLiczba.h"
+#include "LiczbaModulo.h"
+#include "WierszModulo2.h"
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+template <typename T>
+static constexpr uint8_t szerokoscTypu() {
+    if constexpr (is_same_v<T, DuzaLiczba>) {
+        return 0;
+    } else if constexpr (is_same_v<T, bool>) {
+        return 1;
+    } else {
+        return sizeof(T);
+    }
+}
+
+static void dopisz(string& bufor, const void* dane, size_t bajty) {
+    bufor.append((const char*) dane, bajty);
+}
+
+static void dopiszLimby(string& bufor, const uint64_t* limby, int dlugosc) {
+    uint32_t liczba = dlugosc;
+    dopisz(bufor, &liczba, sizeof(liczba));
+    dopisz(bufor, limby, sizeof(uint64_t) * dlugosc);
+}
+
+template <typename T>
+static void dopiszWartosc(string& bufor, const T& wartosc) {
+    if constexpr (is_same_v<T, DuzaLiczba>) {
+        dopiszLimby(bufor, wartosc.limby.data(), wartosc.limby.size());
+    } else if constexpr (is_same_v<T, bool>) {
+        bufor += (char) wartosc;
+    } else {
+        dopisz(bufor, &wartosc, sizeof(T));
+    }
+}
+
+// Bufor zaczyna się od miejsca na nagłówek, który uzupełniamy, gdy znana jest już długość danych.
+static string nowaRamka() {
+    return string(sizeof(NaglowekRamki), '\0');
+}
+
+static void zapiszRamke(FILE* plik, string& bufor, RodzajRamki rodzaj, uint8_t szerokosc,
+                        long long n, long long od, long long doK) {
+    NaglowekRamki naglowek{};
+    naglowek.dlugosc = bufor.size() - sizeof(naglowek.dlugosc);
+    naglowek.rodzaj = (uint8_t) rodzaj;
+    naglowek.szerokosc = szerokosc;
+    naglowek.n = n;
+    naglowek.od = od;
+    naglowek.doK = doK;
+    memcpy(bufor.data(), &naglowek, sizeof(naglowek));
+    fwrite(bufor.data(), 1, bufor.size(), plik);
+}
+
+template <typename T>
+void FormatBinarny::zapiszWiersz(FILE* plik, WierszTrojkataPascala<T>& wiersz) {
+    int n = wiersz.size - 1;
+    string bufor = nowaRamka();
+    if constexpr (is_same_v<T, bool>) {
+        bufor.resize(bufor.size() + wiersz.size);
+        char* dane = bufor.data() + sizeof(NaglowekRamki);
+        for (int i = 0; i < wiersz.size; ++i) {
+            dane[i] = (wiersz.slowa[i >> 6] >> (i & 63)) & 1;
+        }
+    } else if constexpr (is_same_v<T, DuzaLiczba>) {
+        for (int i = 0; i < wiersz.size; ++i) {
+            int j = i < wiersz.przechowywane ? i : n - i;
+            dopiszLimby(bufor, wiersz.arena + (size_t) j * wiersz.szerokosc, wiersz.dlugosci[j]);
+        }
+    } else {
+        // Przechowywana część wiersza idzie jednym kawałkiem, resztę odbijamy od środka.
+        dopisz(bufor, wiersz.tablica, sizeof(T) * wiersz.przechowywane);
+        for (int i = wiersz.przechowywane; i < wiersz.size; ++i) {
+            dopisz(bufor, &wiersz.tablica[n - i], sizeof(T));
+        }
+    }
+    zapiszRamke(plik, bufor, RodzajRamki::wiersz, szerokoscTypu<T>(), n, 0, n);
+}
+
+template <typename T>
+void FormatBinarny::zapiszElement(FILE* plik, WierszTrojkataPascala<T>& wiersz, int m) {
+    string bufor = nowaRamka();
+    dopiszWartosc(bufor, wiersz.MtyElementWiersza(m));
+    zapiszRamke(plik, bufor, RodzajRamki::element, szerokoscTypu<T>(), wiersz.size - 1, m, m);
+}
+
+template <typename T>
+void FormatBinarny::zapiszSume(FILE* plik, WierszTrojkataPascala<T>& wiersz, int a, int b) {
+    string bufor = nowaRamka();
+    dopiszWartosc(bufor, wiersz.sumaZakresu(a, b));
+    zapiszRamke(plik, bufor, RodzajRamki::suma, szerokoscTypu<T>(), wiersz.size - 1, a, b);
+}
+
+void FormatBinarny::zapiszWiersz(FILE* plik, WierszPromowany& wiersz) {
+    wiersz.dlaWiersza([&](auto& w) { zapiszWiersz(plik, w); });
+}
+
+void FormatBinarny::zapiszElement(FILE* plik, WierszPromowany& wiersz, int m) {
+    wiersz.dlaWiersza([&](auto& w) { zapiszElement(plik, w, m); });
+}
+
+// Szerokość sumy to szerokość typu, w którym się zmieściła, więc może być większa niż w ramce wiersza.
+void FormatBinarny::zapiszSume(FILE* plik, WierszPromowany& wiersz, int a, int b) {
+    wiersz.dlaSumy(a, b, [&](const auto& suma) {
+        string bufor = nowaRamka();
+        dopiszWartosc(bufor, suma);
+        zapiszRamke(plik, bufor, RodzajRamki::suma, szerokoscTypu<decay_t<decltype(suma)>>(), wiersz.size - 1, a, b);
+    });
+}
+
+void FormatBinarny::zapiszBlad(FILE* plik, long long n, const string& komunikat) {
+    string bufor = nowaRamka();
+    bufor += komunikat;
+    zapiszRamke(plik, bufor, RodzajRamki::blad, 1, n, 0, 0);
+}
+
+template void FormatBinarny::zapiszWiersz(FILE*, WierszTrojkataPascala<int>&);
+template void FormatBinarny::zapiszWiersz(FILE*, WierszTrojkataPascala<uint64_t>&);
+template void FormatBinarny::zapiszWiersz(FILE*, WierszTrojkataPascala<unsigned __int128>&);
+template void FormatBinarny::zapiszWiersz(FILE*, WierszTrojkataPascala<LiczbaModulo>&);
+template void FormatBinarny::zapiszWiersz(FILE*, WierszTrojkataPascala<DuzaLiczba>&);
+template void FormatBinarny::zapiszWiersz(FILE*, WierszTrojkataPascala<bool>&);
+template void FormatBinarny::zapiszElement(FILE*, WierszTrojkataPascala<int>&, int);
+template void FormatBinarny::zapiszElement(FILE*, WierszTrojkataPascala<uint64_t>&, int);
+template void FormatBinarny::zapiszElement(FILE*, WierszTrojkataPascala<unsigned __int128>&, int);
+template void FormatBinarny::zapiszElement(FILE*, WierszTrojkataPascala<LiczbaModulo>&, int);
+template void FormatBinarny::zapiszElement(FILE*, WierszTrojkataPascala<DuzaLiczba>&, int);
+template void FormatBinarny::zapiszElement(FILE*, WierszTrojkataPascala<bool>&, int);
+template void FormatBinarny::zapiszSume(FILE*, WierszTrojkataPascala<int>&, int, int);
+template void FormatBinarny::zapiszSume(FILE*, WierszTrojkataPascala<uint64_t>&, int, int);
+template void FormatBinarny::zapiszSume(FILE*, WierszTrojkataPascala<unsigned __int128>&, int, int);
+template void FormatBinarny::zapiszSume(FILE*, WierszTrojkataPascala<LiczbaModulo>&, int, int);
+template void FormatBinarny::zapiszSume(FILE*, WierszTrojkataPascala<DuzaLiczba>&, int, int);
+template void FormatBinarny::zapiszSume(FILE*, WierszTrojkataPascala<bool>&, int, int);
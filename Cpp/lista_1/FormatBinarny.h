@@ -0,0 +1,46 @@
+#ifndef FORMATBINARNY_H
+#define FORMATBINARNY_H
+
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "WierszTrojkataPascala.h"
+#include "WierszPromowany.h"
+
+// Wyjście --format=binary: ciąg ramek, każda z 32-bajtowym nagłówkiem little-endian.
+// dlugosc to liczba bajtów ramki po tym polu, więc odbiorca czyta 4 bajty, a potem
+// całą resztę ramki jednym odczytem. Dane to elementy od..doK (wiersz), jedna wartość
+// (element, suma) albo tekst UTF-8 (błąd). Elementy mają po szerokosc bajtów; przy
+// szerokosc == 0 każdy element to uint32 liczba limbów i tyle limbów uint64 od najmłodszego.
+struct NaglowekRamki {
+    uint32_t dlugosc;
+    uint8_t rodzaj;
+    uint8_t szerokosc;
+    uint16_t zarezerwowane;
+    int64_t n;
+    int64_t od;
+    int64_t doK;
+};
+
+static_assert(sizeof(NaglowekRamki) == 32);
+static_assert(std::endian::native == std::endian::little);
+
+enum class RodzajRamki : uint8_t { wiersz, element, suma, blad };
+
+// Szerokości: bool (modulo 2) 1, int i LiczbaModulo 4, uint64_t 8, unsigned __int128 16, DuzaLiczba 0.
+class FormatBinarny {
+public:
+    template <typename T>
+    static void zapiszWiersz(FILE* plik, WierszTrojkataPascala<T>& wiersz);
+    template <typename T>
+    static void zapiszElement(FILE* plik, WierszTrojkataPascala<T>& wiersz, int m);
+    template <typename T>
+    static void zapiszSume(FILE* plik, WierszTrojkataPascala<T>& wiersz, int a, int b);
+    static void zapiszWiersz(FILE* plik, WierszPromowany& wiersz);
+    static void zapiszElement(FILE* plik, WierszPromowany& wiersz, int m);
+    static void zapiszSume(FILE* plik, WierszPromowany& wiersz, int a, int b);
+    static void zapiszBlad(FILE* plik, long long n, const std::string& komunikat);
+};
+
+#endif
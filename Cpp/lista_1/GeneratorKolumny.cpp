@@ -0,0 +1,52 @@
+#include "GeneratorKolumny.h"
+#include "LiczbaModulo.h"
+#include "KrokSymbolu.h"
+#include "DuzaLiczba.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+template <typename T>
+GeneratorKolumny<T>::GeneratorKolumny(long long k, long long K) : k(k), K(K), wartosc(1), n(k) {
+    if (k < 0) {
+        throw out_of_range(to_string(k) + " - liczba spoza zakresu");
+    }
+    if (K < k) {
+        throw invalid_argument(to_string(K) + " - nieprawidłowy numer wiersza");
+    }
+}
+
+template <typename T>
+typename GeneratorKolumny<T>::Iterator GeneratorKolumny<T>::begin() {
+    wartosc = T(1);
+    n = k;
+    return Iterator(this, k);
+}
+
+template <typename T>
+typename GeneratorKolumny<T>::Iterator GeneratorKolumny<T>::end() {
+    return Iterator(this, K + 1);
+}
+
+// Ten sam krok co w GeneratorWiersza, tylko C(n + 1, k) = C(n, k) * (n + 1) / (n + 1 - k).
+template <typename T>
+void GeneratorKolumny<T>::krok() {
+    if (n >= K) {
+        ++n;
+        return;
+    }
+    unsigned long long licznik = n + 1;
+    unsigned long long mianownik = n + 1 - k;
+    ++n;
+
+    if (!krokSymbolu(wartosc, licznik, mianownik, n, k, K)) {
+        throw overflow_error(to_string(n) + " - wynik przekracza zakres typu");
+    }
+}
+
+template class GeneratorKolumny<int>;
+template class GeneratorKolumny<uint64_t>;
+template class GeneratorKolumny<unsigned __int128>;
+template class GeneratorKolumny<LiczbaModulo>;
+template class GeneratorKolumny<DuzaLiczba>;
@@ -0,0 +1,54 @@
+#ifndef GENERATORKOLUMNY_H
+#define GENERATORKOLUMNY_H
+
+#include <cstddef>
+#include <iterator>
+
+// Jednoprzebiegowe przejście w dół kolumny k: C(k, k), C(k + 1, k), ..., C(K, k) ze wzoru
+// C(n + 1, k) = C(n, k) * (n + 1) / (n + 1 - k), w O(K) bez budowania żadnego wiersza.
+// Typy i przepełnienia jak w GeneratorWiersza; dla LiczbaModulo i K >= p elementy liczone są Lucasem.
+template <typename T>
+class GeneratorKolumny {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator(GeneratorKolumny* generator, long long n) : generator(generator), n(n) {}
+
+        const T& operator*() const {
+            return generator->wartosc;
+        }
+
+        Iterator& operator++() {
+            generator->krok();
+            ++n;
+            return *this;
+        }
+
+        bool operator==(const Iterator& inny) const {
+            return n == inny.n;
+        }
+
+    private:
+        GeneratorKolumny* generator;
+        long long n;
+    };
+
+    GeneratorKolumny(long long k, long long K);
+    Iterator begin();
+    Iterator end();
+    long long k;
+    long long K;
+
+private:
+    void krok();
+    T wartosc;
+    long long n;
+};
+
+#endif
@@ -0,0 +1,50 @@
+#include "GeneratorWiersza.h"
+#include "LiczbaModulo.h"
+#include "KrokSymbolu.h"
+#include "DuzaLiczba.h"
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+template <typename T>
+GeneratorWiersza<T>::GeneratorWiersza(long long n) : n(n), wartosc(1), k(0) {
+    if (n < 0) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+}
+
+template <typename T>
+typename GeneratorWiersza<T>::Iterator GeneratorWiersza<T>::begin() {
+    wartosc = T(1);
+    k = 0;
+    return Iterator(this, 0);
+}
+
+template <typename T>
+typename GeneratorWiersza<T>::Iterator GeneratorWiersza<T>::end() {
+    return Iterator(this, n + 1);
+}
+
+// C(n, k + 1) = C(n, k) * (n - k) / (k + 1); przepełnienie zgłaszamy tylko wtedy,
+// gdy C(n, k + 1) naprawdę nie mieści się w T (patrz krokSymbolu).
+template <typename T>
+void GeneratorWiersza<T>::krok() {
+    if (k >= n) {
+        ++k;
+        return;
+    }
+    unsigned long long licznik = n - k;
+    unsigned long long mianownik = k + 1;
+    ++k;
+
+    if (!krokSymbolu(wartosc, licznik, mianownik, n, k, n)) {
+        throw overflow_error(to_string(k) + " - wynik przekracza zakres typu");
+    }
+}
+
+template class GeneratorWiersza<int>;
+template class GeneratorWiersza<uint64_t>;
+template class GeneratorWiersza<unsigned __int128>;
+template class GeneratorWiersza<LiczbaModulo>;
+template class GeneratorWiersza<DuzaLiczba>;
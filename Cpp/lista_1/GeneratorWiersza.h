@@ -0,0 +1,54 @@
+#ifndef GENERATORWIERSZA_H
+#define GENERATORWIERSZA_H
+
+#include <cstddef>
+#include <iterator>
+
+// Jednoprzebiegowe przejście po wierszu n: C(n, 0), C(n, 1), ..., C(n, n) ze wzoru
+// C(n, k + 1) = C(n, k) * (n - k) / (k + 1), bez trzymania wiersza w pamięci.
+// Dla typów stałej szerokości wynik jest dokładny albo krok rzuca overflow_error,
+// LiczbaModulo wymaga pierwszego modułu p; dla n >= p elementy liczone są twierdzeniem Lucasa.
+template <typename T>
+class GeneratorWiersza {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator(GeneratorWiersza* generator, long long k) : generator(generator), k(k) {}
+
+        const T& operator*() const {
+            return generator->wartosc;
+        }
+
+        Iterator& operator++() {
+            generator->krok();
+            ++k;
+            return *this;
+        }
+
+        bool operator==(const Iterator& inny) const {
+            return k == inny.k;
+        }
+
+    private:
+        GeneratorWiersza* generator;
+        long long k;
+    };
+
+    explicit GeneratorWiersza(long long n);
+    Iterator begin();
+    Iterator end();
+    long long n;
+
+private:
+    void krok();
+    T wartosc;
+    long long k;
+};
+
+#endif
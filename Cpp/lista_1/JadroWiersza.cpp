@@ -0,0 +1,174 @@
+#include "JadroWiersza.h"
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define JADRO_X86
+#endif
+
+using namespace std;
+
+static void dodaj32Ogolnie(uint32_t* a, int r) {
+    for (int i = r - 1; i > 0; --i) {
+        a[i] += a[i - 1];
+    }
+}
+
+static void dodaj64Ogolnie(uint64_t* a, int r) {
+    for (int i = r - 1; i > 0; --i) {
+        a[i] += a[i - 1];
+    }
+}
+
+static void dodajModuloOgolnie(uint32_t* a, int r, uint32_t p) {
+    for (int i = r - 1; i > 0; --i) {
+        uint32_t suma = a[i] + a[i - 1];
+        uint32_t bezModulu = suma - p;
+        a[i] = suma < bezModulu ? suma : bezModulu;
+    }
+}
+
+#ifdef JADRO_X86
+
+// Blok a[i-W+1..i] czytamy razem z a[i-W..i-1] przed zapisem, a kolejny blok
+// zapisuje tylko indeksy mniejsze, więc lewy sąsiad jest zawsze jeszcze z wiersza r-1.
+
+__attribute__((target("sse4.1")))
+static void dodaj32Sse4(uint32_t* a, int r) {
+    int i = r - 1;
+    for (; i >= 4; i -= 4) {
+        __m128i biezacy = _mm_loadu_si128((const __m128i*) (a + i - 3));
+        __m128i lewy = _mm_loadu_si128((const __m128i*) (a + i - 4));
+        _mm_storeu_si128((__m128i*) (a + i - 3), _mm_add_epi32(biezacy, lewy));
+    }
+    dodaj32Ogolnie(a, i + 1);
+}
+
+__attribute__((target("sse4.1")))
+static void dodaj64Sse4(uint64_t* a, int r) {
+    int i = r - 1;
+    for (; i >= 2; i -= 2) {
+        __m128i biezacy = _mm_loadu_si128((const __m128i*) (a + i - 1));
+        __m128i lewy = _mm_loadu_si128((const __m128i*) (a + i - 2));
+        _mm_storeu_si128((__m128i*) (a + i - 1), _mm_add_epi64(biezacy, lewy));
+    }
+    dodaj64Ogolnie(a, i + 1);
+}
+
+__attribute__((target("sse4.1")))
+static void dodajModuloSse4(uint32_t* a, int r, uint32_t p) {
+    __m128i modul = _mm_set1_epi32((int) p);
+    int i = r - 1;
+    for (; i >= 4; i -= 4) {
+        __m128i biezacy = _mm_loadu_si128((const __m128i*) (a + i - 3));
+        __m128i lewy = _mm_loadu_si128((const __m128i*) (a + i - 4));
+        __m128i suma = _mm_add_epi32(biezacy, lewy);
+        _mm_storeu_si128((__m128i*) (a + i - 3), _mm_min_epu32(suma, _mm_sub_epi32(suma, modul)));
+    }
+    dodajModuloOgolnie(a, i + 1, p);
+}
+
+__attribute__((target("avx2")))
+static void dodaj32Avx2(uint32_t* a, int r) {
+    int i = r - 1;
+    for (; i >= 8; i -= 8) {
+        __m256i biezacy = _mm256_loadu_si256((const __m256i*) (a + i - 7));
+        __m256i lewy = _mm256_loadu_si256((const __m256i*) (a + i - 8));
+        _mm256_storeu_si256((__m256i*) (a + i - 7), _mm256_add_epi32(biezacy, lewy));
+    }
+    dodaj32Ogolnie(a, i + 1);
+}
+
+__attribute__((target("avx2")))
+static void dodaj64Avx2(uint64_t* a, int r) {
+    int i = r - 1;
+    for (; i >= 4; i -= 4) {
+        __m256i biezacy = _mm256_loadu_si256((const __m256i*) (a + i - 3));
+        __m256i lewy = _mm256_loadu_si256((const __m256i*) (a + i - 4));
+        _mm256_storeu_si256((__m256i*) (a + i - 3), _mm256_add_epi64(biezacy, lewy));
+    }
+    dodaj64Ogolnie(a, i + 1);
+}
+
+__attribute__((target("avx2")))
+static void dodajModuloAvx2(uint32_t* a, int r, uint32_t p) {
+    __m256i modul = _mm256_set1_epi32((int) p);
+    int i = r - 1;
+    for (; i >= 8; i -= 8) {
+        __m256i biezacy = _mm256_loadu_si256((const __m256i*) (a + i - 7));
+        __m256i lewy = _mm256_loadu_si256((const __m256i*) (a + i - 8));
+        __m256i suma = _mm256_add_epi32(biezacy, lewy);
+        _mm256_storeu_si256((__m256i*) (a + i - 7), _mm256_min_epu32(suma, _mm256_sub_epi32(suma, modul)));
+    }
+    dodajModuloOgolnie(a, i + 1, p);
+}
+
+#endif
+
+static PoziomISA aktualnyPoziom = PoziomISA::ogolny;
+static void (*dodaj32)(uint32_t*, int) = dodaj32Ogolnie;
+static void (*dodaj64)(uint64_t*, int) = dodaj64Ogolnie;
+static void (*dodajModulo)(uint32_t*, int, uint32_t) = dodajModuloOgolnie;
+
+static const bool poziomUstawiony = (JadroWiersza::ustawPoziom(JadroWiersza::wykryjPoziom()), true);
+
+void JadroWiersza::dodajSasiednie(uint32_t* a, int r) {
+    dodaj32(a, r);
+}
+
+void JadroWiersza::dodajSasiednie(uint64_t* a, int r) {
+    dodaj64(a, r);
+}
+
+void JadroWiersza::dodajSasiednieModulo(uint32_t* a, int r, uint32_t p) {
+    dodajModulo(a, r, p);
+}
+
+PoziomISA JadroWiersza::wykryjPoziom() {
+#ifdef JADRO_X86
+    if (__builtin_cpu_supports("avx2")) {
+        return PoziomISA::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return PoziomISA::sse4;
+    }
+#endif
+    return PoziomISA::ogolny;
+}
+
+PoziomISA JadroWiersza::poziom() {
+    return aktualnyPoziom;
+}
+
+void JadroWiersza::ustawPoziom(PoziomISA poziom) {
+    if (poziom > wykryjPoziom()) {
+        throw invalid_argument(string(nazwa(poziom)) + " - poziom nieobsługiwany przez procesor");
+    }
+    aktualnyPoziom = poziom;
+    dodaj32 = dodaj32Ogolnie;
+    dodaj64 = dodaj64Ogolnie;
+    dodajModulo = dodajModuloOgolnie;
+#ifdef JADRO_X86
+    if (poziom == PoziomISA::sse4) {
+        dodaj32 = dodaj32Sse4;
+        dodaj64 = dodaj64Sse4;
+        dodajModulo = dodajModuloSse4;
+    } else if (poziom == PoziomISA::avx2) {
+        dodaj32 = dodaj32Avx2;
+        dodaj64 = dodaj64Avx2;
+        dodajModulo = dodajModuloAvx2;
+    }
+#endif
+}
+
+const char* JadroWiersza::nazwa(PoziomISA poziom) {
+    switch (poziom) {
+        case PoziomISA::sse4:
+            return "SSE4.1";
+        case PoziomISA::avx2:
+            return "AVX2";
+        default:
+            return "ogólny";
+    }
+}
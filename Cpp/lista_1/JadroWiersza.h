@@ -0,0 +1,63 @@
+#ifndef JADROWIERSZA_H
+#define JADROWIERSZA_H
+
+#include <cstdint>
+#include <type_traits>
+#include "LiczbaModulo.h"
+
+enum class PoziomISA { ogolny, sse4, avx2 };
+
+// Krok z wiersza r-1 do wiersza r w miejscu: a[i] += a[i - 1] dla i = r-1..1 (od prawej).
+// Wersja wektorowa wybierana jest przy starcie programu według możliwości procesora.
+// Dodawanie 32-bitowe jest modulo 2^32, tak jak przepełnienie int w poprzedniej wersji.
+class JadroWiersza {
+public:
+    static void dodajSasiednie(uint32_t* a, int r);
+    static void dodajSasiednie(uint64_t* a, int r);
+    static void dodajSasiednieModulo(uint32_t* a, int r, uint32_t p);
+
+    static PoziomISA wykryjPoziom();
+    static PoziomISA poziom();
+    static void ustawPoziom(PoziomISA poziom);
+    static const char* nazwa(PoziomISA poziom);
+
+    // Jądro dobrane do typu elementu; typy bez wersji wektorowej idą zwykłą pętlą.
+    template <typename T>
+    static void dodajSasiednie(T* a, int r) {
+        if constexpr (std::is_same_v<T, int>) {
+            dodajSasiednie(reinterpret_cast<uint32_t*>(a), r);
+        } else if constexpr (std::is_same_v<T, LiczbaModulo>) {
+            dodajSasiednieModulo(reinterpret_cast<uint32_t*>(a), r, LiczbaModulo::modul);
+        } else {
+            for (int i = r - 1; i > 0; --i) {
+                a[i] += a[i - 1];
+            }
+        }
+    }
+
+    // Wersja poza miejscem: biezacy[i] = poprzedni[i - 1] + poprzedni[i] dla i z [od, doIndeksu), od > 0.
+    // Bez zależności między iteracjami, więc kompilator sam ją wektoryzuje.
+    template <typename T>
+    static void sumujSasiednie(const T* poprzedni, T* biezacy, int od, int doIndeksu) {
+        if constexpr (std::is_same_v<T, int>) {
+            sumujSasiednie(reinterpret_cast<const uint32_t*>(poprzedni), reinterpret_cast<uint32_t*>(biezacy),
+                           od, doIndeksu);
+        } else if constexpr (std::is_same_v<T, LiczbaModulo>) {
+            const uint32_t* z = reinterpret_cast<const uint32_t*>(poprzedni);
+            uint32_t* w = reinterpret_cast<uint32_t*>(biezacy);
+            uint32_t p = LiczbaModulo::modul;
+            for (int i = od; i < doIndeksu; ++i) {
+                uint32_t suma = z[i - 1] + z[i];
+                uint32_t bezModulu = suma - p;
+                w[i] = suma < bezModulu ? suma : bezModulu;
+            }
+        } else {
+            for (int i = od; i < doIndeksu; ++i) {
+                biezacy[i] = poprzedni[i - 1];
+                biezacy[i] += poprzedni[i];
+            }
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,77 @@
+#include "KrokSymbolu.h"
+#include "LiczbaModulo.h"
+#include "SymbolNewtonaModulo.h"
+#include "DuzaLiczba.h"
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+using namespace std;
+
+template <typename T>
+bool krokSymbolu(T& wartosc, unsigned long long licznik, unsigned long long mianownik,
+                 long long n, long long k, long long zakres) {
+    if constexpr (is_same_v<T, LiczbaModulo>) {
+        const SymbolNewtonaModulo& symbol = SymbolNewtonaModulo::dlaModulu(LiczbaModulo::modul);
+        if ((unsigned long long) zakres < symbol.p) {
+            uint64_t iloczyn = (uint64_t) wartosc.wartosc * (licznik % symbol.p) % symbol.p;
+            wartosc.wartosc = iloczyn * symbol.odwrotnosc(mianownik) % symbol.p;
+        } else {
+            wartosc.wartosc = symbol.oblicz(n, k);
+        }
+    } else if constexpr (is_same_v<T, DuzaLiczba>) {
+        wartosc.pomnoz(licznik);
+        wartosc.podziel(mianownik);
+    } else {
+        using Szeroki = conditional_t<is_same_v<T, int>, uint64_t, T>;
+        Szeroki biezaca = wartosc;
+        unsigned long long dzielnik = gcd((unsigned long long) (biezaca % mianownik), mianownik);
+        biezaca /= dzielnik;
+        mianownik /= dzielnik;
+        licznik /= mianownik;
+        Szeroki nastepna;
+        if (__builtin_mul_overflow(biezaca, (Szeroki) licznik, &nastepna)
+            || (is_same_v<T, int> && nastepna > (Szeroki) INT_MAX)) {
+            return false;
+        }
+        wartosc = (T) nastepna;
+    }
+    return true;
+}
+
+template <typename T>
+T symbolNewtonaWTypie(long long n, long long m) {
+    if (n < 0) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    if (m < 0 || m > n) {
+        throw out_of_range(to_string(m) + " - liczba spoza zakresu");
+    }
+    long long k = min(m, n - m);
+    T wartosc(1);
+    if constexpr (is_same_v<T, LiczbaModulo>) {
+        wartosc.wartosc = SymbolNewtonaModulo::dlaModulu(LiczbaModulo::modul).oblicz(n, k);
+    } else {
+        for (long long i = 0; i < k; ++i) {
+            if (!krokSymbolu(wartosc, n - i, i + 1, n, i + 1, n)) {
+                throw overflow_error(to_string(m) + " - wynik przekracza zakres typu");
+            }
+        }
+    }
+    return wartosc;
+}
+
+template bool krokSymbolu(int&, unsigned long long, unsigned long long, long long, long long, long long);
+template bool krokSymbolu(uint64_t&, unsigned long long, unsigned long long, long long, long long, long long);
+template bool krokSymbolu(unsigned __int128&, unsigned long long, unsigned long long, long long, long long,
+                          long long);
+template bool krokSymbolu(LiczbaModulo&, unsigned long long, unsigned long long, long long, long long, long long);
+template bool krokSymbolu(DuzaLiczba&, unsigned long long, unsigned long long, long long, long long, long long);
+template int symbolNewtonaWTypie(long long, long long);
+template uint64_t symbolNewtonaWTypie(long long, long long);
+template unsigned __int128 symbolNewtonaWTypie(long long, long long);
+template LiczbaModulo symbolNewtonaWTypie(long long, long long);
+template DuzaLiczba symbolNewtonaWTypie(long long, long long);
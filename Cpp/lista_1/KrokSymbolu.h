@@ -0,0 +1,19 @@
+#ifndef KROKSYMBOLU_H
+#define KROKSYMBOLU_H
+
+// Wspólny krok GeneratorWiersza i GeneratorKolumny: z wartosc = C(.., ..) robi C(n, k),
+// mnożąc przez licznik i dzieląc przez mianownik (iloraz zawsze jest całkowity).
+// Typy stałej szerokości skracają przez nwd przed mnożeniem, więc false zwracamy tylko wtedy,
+// gdy C(n, k) naprawdę nie mieści się w T; wartosc zostaje wtedy bez zmian.
+// Dla LiczbaModulo odwrotność mianownika wystarcza, gdy zakres (największe n generatora) < p,
+// bo wtedy żaden czynnik nie dzieli się przez p; w przeciwnym razie C(n, k) liczymy wprost.
+template <typename T>
+bool krokSymbolu(T& wartosc, unsigned long long licznik, unsigned long long mianownik,
+                 long long n, long long k, long long zakres);
+
+// Pojedyncze C(n, m) w typie T kolejnymi krokami krokSymbolu, bez budowania wiersza;
+// overflow_error, gdy wynik nie mieści się w T. LiczbaModulo liczy C(n, m) mod p wprost.
+template <typename T>
+T symbolNewtonaWTypie(long long n, long long m);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef LICZBAMODULO_H
+#define LICZBAMODULO_H
+
+#include <cstdint>
+#include <string>
+
+// Reszta modulo p < 2^31, więc suma dwóch reszt mieści się w uint32_t.
+// Moduł jest wspólny dla wszystkich wartości i ustawia się go przed budową wiersza.
+class LiczbaModulo {
+public:
+    LiczbaModulo(uint32_t wartosc = 0) : wartosc(wartosc % modul) {}
+
+    LiczbaModulo& operator+=(LiczbaModulo inna) {
+        uint32_t suma = wartosc + inna.wartosc;
+        uint32_t bezModulu = suma - modul;
+        wartosc = suma < bezModulu ? suma : bezModulu;
+        return *this;
+    }
+
+    LiczbaModulo& operator-=(LiczbaModulo inna) {
+        uint32_t roznica = wartosc - inna.wartosc;
+        uint32_t zModulem = roznica + modul;
+        wartosc = roznica < zModulem ? roznica : zModulem;
+        return *this;
+    }
+
+    static void ustawModul(unsigned long long p);
+
+    inline static uint32_t modul = 1000000007;
+    uint32_t wartosc;
+};
+
+std::string naNapis(LiczbaModulo liczba);
+
+#endif
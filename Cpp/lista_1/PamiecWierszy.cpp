@@ -0,0 +1,85 @@
+#include "PamiecWierszy.h"
+#include "LiczbaModulo.h"
+#include "DuzaLiczba.h"
+#include <stdexcept>
+
+using namespace std;
+
+template <typename T>
+PamiecWierszy<T>::PamiecWierszy(size_t limitBajtow) : limitBajtow(limitBajtow) {}
+
+template <typename T>
+WierszTrojkataPascala<T>& PamiecWierszy<T>::wiersz(int n) {
+    doliczPierwszy();
+    auto znaleziony = wedlugN.find(n);
+    if (znaleziony != wedlugN.end()) {
+        ++trafienia;
+        kolejnosc.splice(kolejnosc.begin(), kolejnosc, znaleziony->second);
+        return znaleziony->second->wiersz;
+    }
+
+    ++chybienia;
+    PulaWierszy::Uzycie uzycie(pula);
+    auto ponizej = wedlugN.lower_bound(n);
+    bool odPoprzedniego = n >= 0 && ponizej != wedlugN.begin();
+    if (odPoprzedniego) {
+        --ponizej;
+    }
+    WierszTrojkataPascala<T> nowy = odPoprzedniego
+        ? WierszTrojkataPascala<T>(ponizej->second->wiersz, n, true)
+        : WierszTrojkataPascala<T>(n, Przechowywanie::polowa, true);
+    if (nowy.size - 1 < n) {
+        throw overflow_error(to_string(n) + " - wynik przekracza zakres typu (ostatni dokładny wiersz: "
+                             + to_string(nowy.size - 1) + ")");
+    }
+
+    size_t bajty = nowy.zajetaPamiec();
+    zajete += bajty;
+    kolejnosc.push_front(Wpis{n, bajty, std::move(nowy)});
+    wedlugN[n] = kolejnosc.begin();
+    zwolnijMiejsce();
+    return kolejnosc.front().wiersz;
+}
+
+// Tylko wiersz zwrócony ostatnio (pierwszy na liście) mógł od tego czasu dobudować bufory.
+template <typename T>
+void PamiecWierszy<T>::doliczPierwszy() {
+    if (kolejnosc.empty()) {
+        return;
+    }
+    Wpis& pierwszy = kolejnosc.front();
+    size_t bajty = pierwszy.wiersz.zajetaPamiec();
+    zajete += bajty - pierwszy.naliczone;
+    pierwszy.naliczone = bajty;
+}
+
+// Najdawniej używane wiersze idą pierwsze; właśnie dodany zostaje, nawet jeśli sam przekracza limit.
+template <typename T>
+void PamiecWierszy<T>::zwolnijMiejsce() {
+    while (zajete > limitBajtow && kolejnosc.size() > 1) {
+        Wpis& ostatni = kolejnosc.back();
+        zajete -= ostatni.naliczone;
+        wedlugN.erase(ostatni.n);
+        kolejnosc.pop_back();
+        ++wyrzucenia;
+    }
+}
+
+template <typename T>
+size_t PamiecWierszy<T>::zajetaPamiec() const {
+    if (kolejnosc.empty()) {
+        return zajete;
+    }
+    return zajete + kolejnosc.front().wiersz.zajetaPamiec() - kolejnosc.front().naliczone;
+}
+
+template <typename T>
+size_t PamiecWierszy<T>::liczbaWierszy() const {
+    return kolejnosc.size();
+}
+
+template class PamiecWierszy<int>;
+template class PamiecWierszy<uint64_t>;
+template class PamiecWierszy<unsigned __int128>;
+template class PamiecWierszy<LiczbaModulo>;
+template class PamiecWierszy<DuzaLiczba>;
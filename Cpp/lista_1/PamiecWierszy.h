@@ -0,0 +1,47 @@
+#ifndef PAMIECWIERSZY_H
+#define PAMIECWIERSZY_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include "WierszTrojkataPascala.h"
+#include "PulaWierszy.h"
+
+// Pamięć podręczna LRU wierszy z limitem zajętej pamięci w bajtach.
+// Brakujący wiersz n liczony jest od najbliższego zapamiętanego wiersza poniżej n.
+// Referencja zwrócona przez wiersz() jest ważna do następnego wywołania.
+// Wiersz, którego elementy nie mieszczą się w T, daje overflow_error zamiast zawiniętych wartości.
+template <typename T>
+class PamiecWierszy {
+public:
+    explicit PamiecWierszy(size_t limitBajtow);
+    WierszTrojkataPascala<T>& wiersz(int n);
+    size_t zajetaPamiec() const;
+    size_t liczbaWierszy() const;
+
+    size_t limitBajtow;
+    long long trafienia = 0;
+    long long chybienia = 0;
+    long long wyrzucenia = 0;
+    // Bufory wierszy; wyrzucony wiersz oddaje bufor następnemu z tej samej klasy rozmiaru.
+    PulaWierszy pula;
+
+private:
+    // Wiersze leżą w węzłach listy, więc splice i przeniesienie do listy nie ruszają ich buforów.
+    // naliczone to bajty wiersza wliczone do zajete; sumy i przepełnienia dobudowane później
+    // przez wywołującego doliczamy, zanim wiersz zejdzie z początku listy.
+    struct Wpis {
+        int n;
+        size_t naliczone;
+        WierszTrojkataPascala<T> wiersz;
+    };
+
+    void doliczPierwszy();
+    void zwolnijMiejsce();
+
+    std::list<Wpis> kolejnosc;
+    std::map<int, typename std::list<Wpis>::iterator> wedlugN;
+    size_t zajete = 0;
+};
+
+#endif
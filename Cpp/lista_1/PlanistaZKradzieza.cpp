@@ -0,0 +1,67 @@
+#include "PlanistaZKradzieza.h"
+#include <algorithm>
+#include <thread>
+
+using namespace std;
+
+PlanistaZKradzieza::PlanistaZKradzieza(int liczbaWatkow) : kolejki(max(liczbaWatkow, 1)) {}
+
+int PlanistaZKradzieza::liczbaWatkow() const {
+    return (int) kolejki.size();
+}
+
+void PlanistaZKradzieza::dodaj(int watek, long long zadanie) {
+    lock_guard<mutex> zamek(kolejki[watek].blokada);
+    kolejki[watek].zadania.push_back(zadanie);
+}
+
+bool PlanistaZKradzieza::wez(int watek, long long& zadanie) {
+    {
+        Kolejka& wlasna = kolejki[watek];
+        lock_guard<mutex> zamek(wlasna.blokada);
+        if (!wlasna.zadania.empty()) {
+            zadanie = wlasna.zadania.back();
+            wlasna.zadania.pop_back();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < kolejki.size(); ++i) {
+        Kolejka& ofiara = kolejki[(watek + i) % kolejki.size()];
+        lock_guard<mutex> zamek(ofiara.blokada);
+        if (!ofiara.zadania.empty()) {
+            zadanie = ofiara.zadania.front();
+            ofiara.zadania.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void PlanistaZKradzieza::uruchom(const vector<long long>& poczatkowe, long long liczbaZadan,
+                                 const function<void(long long, int)>& wykonaj) {
+    zakonczone = 0;
+    for (size_t i = 0; i < poczatkowe.size(); ++i) {
+        dodaj(i % kolejki.size(), poczatkowe[i]);
+    }
+
+    auto petla = [&](int watek) {
+        long long zadanie;
+        while (zakonczone.load(memory_order_acquire) < liczbaZadan) {
+            if (wez(watek, zadanie)) {
+                wykonaj(zadanie, watek);
+                zakonczone.fetch_add(1, memory_order_release);
+            } else {
+                this_thread::yield();
+            }
+        }
+    };
+
+    vector<thread> watki;
+    for (int i = 1; i < liczbaWatkow(); ++i) {
+        watki.emplace_back(petla, i);
+    }
+    petla(0);
+    for (thread& watek : watki) {
+        watek.join();
+    }
+}
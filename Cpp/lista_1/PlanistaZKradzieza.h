@@ -0,0 +1,33 @@
+#ifndef PLANISTAZKRADZIEZA_H
+#define PLANISTAZKRADZIEZA_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Planista z kradzieżą zadań: każdy wątek ma własną kolejkę, bierze zadania z jej końca,
+// a gdy jest pusta - podkrada z początku kolejki innego wątku.
+// Zadania to liczby; wykonywane zadanie zgłasza gotowe następniki przez dodaj().
+class PlanistaZKradzieza {
+public:
+    explicit PlanistaZKradzieza(int liczbaWatkow);
+    void uruchom(const std::vector<long long>& poczatkowe, long long liczbaZadan,
+                 const std::function<void(long long zadanie, int watek)>& wykonaj);
+    void dodaj(int watek, long long zadanie);
+    int liczbaWatkow() const;
+
+private:
+    struct Kolejka {
+        std::deque<long long> zadania;
+        std::mutex blokada;
+    };
+
+    bool wez(int watek, long long& zadanie);
+
+    std::vector<Kolejka> kolejki;
+    std::atomic<long long> zakonczone{0};
+};
+
+#endif
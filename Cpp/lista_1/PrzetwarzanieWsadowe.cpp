@@ -0,0 +1,89 @@
+#include "PrzetwarzanieWsadowe.h"
+#include "WierszTrojkataPascala.h"
+#include "LiczbaModulo.h"
+#include "DuzaLiczba.h"
+#include "PulaWierszy.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct Zapytanie {
+    int n;
+    int m;
+    size_t pozycja;
+};
+
+template <typename T>
+void PrzetwarzanieWsadowe<T>::przetworz(FILE* wejscie, FILE* wyjscie) {
+    vector<string> odpowiedzi;
+    vector<Zapytanie> zapytania;
+
+    char* bufor = nullptr;
+    size_t pojemnosc = 0;
+    ssize_t dlugosc;
+    while ((dlugosc = getline(&bufor, &pojemnosc, wejscie)) != -1) {
+        string linia(bufor, dlugosc);
+        // Końcowe białe znaki (także '\r' z CRLF i spacje po m) nie są częścią zapytania.
+        while (!linia.empty() && isspace((unsigned char) linia.back())) {
+            linia.pop_back();
+        }
+        if (linia.find_first_not_of(" \t") == string::npos) {
+            continue;
+        }
+
+        char* koniec;
+        long n = strtol(linia.c_str(), &koniec, 10);
+        char* koniecM;
+        long m = strtol(koniec, &koniecM, 10);
+        if (koniec == linia.c_str() || koniecM == koniec || *koniecM != '\0' || n < 0 || n > INT32_MAX - 1) {
+            odpowiedzi.push_back(linia + " - nieprawidłowa dana");
+            continue;
+        }
+        if (m < 0 || m > n) {
+            odpowiedzi.push_back(linia + " - liczba spoza zakresu");
+            continue;
+        }
+
+        zapytania.push_back({(int) n, (int) m, odpowiedzi.size()});
+        odpowiedzi.emplace_back();
+    }
+    free(bufor);
+
+    stable_sort(zapytania.begin(), zapytania.end(), [](const Zapytanie& a, const Zapytanie& b) {
+        return a.n < b.n;
+    });
+
+    // Kolejny wiersz liczony jest od poprzedniego i przenoszony na jego miejsce.
+    // Bufory bierze z puli, zwalnianej w całości po zakończeniu wsadu.
+    PulaWierszy pula;
+    PulaWierszy::Uzycie uzycie(pula);
+    // Wiersz zatrzymany na przepełnieniu jest ostatnim dokładnym, więc większe n też się nie zmieszczą.
+    optional<WierszTrojkataPascala<T>> wiersz;
+    bool przepelniony = false;
+    for (const Zapytanie& zapytanie : zapytania) {
+        if (!wiersz) {
+            wiersz.emplace(zapytanie.n, Przechowywanie::polowa, true);
+        } else if (wiersz->size != zapytanie.n + 1 && !przepelniony) {
+            wiersz = WierszTrojkataPascala<T>(*wiersz, zapytanie.n, true);
+        }
+        przepelniony = wiersz->size != zapytanie.n + 1;
+        odpowiedzi[zapytanie.pozycja] = to_string(zapytanie.n) + " " + to_string(zapytanie.m) + " - "
+            + (przepelniony ? string("wynik przekracza zakres typu") : wiersz->napisElementu(zapytanie.m));
+    }
+
+    for (const string& odpowiedz : odpowiedzi) {
+        fwrite(odpowiedz.data(), 1, odpowiedz.size(), wyjscie);
+        fputc('\n', wyjscie);
+    }
+}
+
+template class PrzetwarzanieWsadowe<int>;
+template class PrzetwarzanieWsadowe<uint64_t>;
+template class PrzetwarzanieWsadowe<unsigned __int128>;
+template class PrzetwarzanieWsadowe<LiczbaModulo>;
+template class PrzetwarzanieWsadowe<DuzaLiczba>;
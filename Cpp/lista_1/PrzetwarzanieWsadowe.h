@@ -0,0 +1,15 @@
+#ifndef PRZETWARZANIEWSADOWE_H
+#define PRZETWARZANIEWSADOWE_H
+
+#include <cstdio>
+
+// Zapytania "n m", po jednym w linii. Zapytania są grupowane według n, a wiersze
+// liczone raz, od najmniejszego n w górę, każdy od poprzedniego - łącznie O(max_n²).
+// Odpowiedzi "n m - wartość" wypisywane są w kolejności wejścia.
+template <typename T>
+class PrzetwarzanieWsadowe {
+public:
+    static void przetworz(FILE* wejscie, FILE* wyjscie);
+};
+
+#endif
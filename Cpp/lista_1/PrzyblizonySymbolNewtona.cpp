@@ -0,0 +1,59 @@
+#include "PrzyblizonySymbolNewtona.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+static const long double LN_2PI = 1.837877066409345483560659472811235279722794947275566825634L;
+
+// Tablica liczona raz, w long double, przy pierwszym zapytaniu.
+static const double* tablicaPoprawek() {
+    static double poprawki[PrzyblizonySymbolNewtona::ROZMIAR_TABLICY];
+    static bool gotowe = [] {
+        long double lnSilni = 0;
+        poprawki[0] = 0;
+        for (int x = 1; x < PrzyblizonySymbolNewtona::ROZMIAR_TABLICY; ++x) {
+            lnSilni += logl(x);
+            poprawki[x] = (double) (lnSilni - (x * logl(x) - x + (LN_2PI + logl(x)) / 2));
+        }
+        return true;
+    }();
+    (void) gotowe;
+    return poprawki;
+}
+
+static double poprawkaStirlinga(long long x) {
+    if (x < PrzyblizonySymbolNewtona::ROZMIAR_TABLICY) {
+        return tablicaPoprawek()[x];
+    }
+    double odwrotnosc = 1.0 / (double) x;
+    double kwadrat = odwrotnosc * odwrotnosc;
+    return odwrotnosc * (1.0 / 12 - kwadrat * (1.0 / 360 - kwadrat / 1260));
+}
+
+double PrzyblizonySymbolNewtona::logarytm(long long n, long long k) {
+    if (n < 0) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    if (k < 0 || k > n) {
+        throw out_of_range(to_string(k) + " - liczba spoza zakresu");
+    }
+    k = min(k, n - k);
+    if (k == 0) {
+        return 0;
+    }
+
+    double dn = (double) n;
+    double dk = (double) k;
+    double reszta = (double) (n - k);
+    return dk * log(dn / dk) - reszta * log1p(-dk / dn)
+           + (log(dn / (dk * reszta)) - (double) LN_2PI) / 2
+           + poprawkaStirlinga(n) - poprawkaStirlinga(k) - poprawkaStirlinga(n - k);
+}
+
+// Dla ln C > ~709.78 wynik nie mieści się w double i wynosi inf.
+double PrzyblizonySymbolNewtona::wartosc(long long n, long long k) {
+    return exp(logarytm(n, k));
+}
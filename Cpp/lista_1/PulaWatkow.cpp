@@ -0,0 +1,64 @@
+#include "PulaWatkow.h"
+
+using namespace std;
+
+PulaWatkow::PulaWatkow(int liczbaWatkow) {
+    for (int i = 0; i < max(liczbaWatkow, 1); ++i) {
+        watki.emplace_back(&PulaWatkow::petla, this);
+    }
+}
+
+PulaWatkow::~PulaWatkow() {
+    {
+        lock_guard<mutex> zamek(blokada);
+        koniec = true;
+    }
+    jestZadanie.notify_all();
+    for (thread& watek : watki) {
+        watek.join();
+    }
+}
+
+void PulaWatkow::dodaj(function<void()> zadanie) {
+    {
+        lock_guard<mutex> zamek(blokada);
+        kolejka.push_back(std::move(zadanie));
+        ++niezakonczone;
+    }
+    jestZadanie.notify_one();
+}
+
+void PulaWatkow::czekaj() {
+    unique_lock<mutex> zamek(blokada);
+    wszystkoGotowe.wait(zamek, [this] { return niezakonczone == 0; });
+}
+
+int PulaWatkow::liczbaWatkow() const {
+    return (int) watki.size();
+}
+
+int PulaWatkow::domyslnaLiczbaWatkow() {
+    return max(1u, thread::hardware_concurrency());
+}
+
+void PulaWatkow::petla() {
+    while (true) {
+        function<void()> zadanie;
+        {
+            unique_lock<mutex> zamek(blokada);
+            jestZadanie.wait(zamek, [this] { return koniec || !kolejka.empty(); });
+            if (kolejka.empty()) {
+                return;
+            }
+            zadanie = std::move(kolejka.front());
+            kolejka.pop_front();
+        }
+        zadanie();
+        {
+            lock_guard<mutex> zamek(blokada);
+            if (--niezakonczone == 0) {
+                wszystkoGotowe.notify_all();
+            }
+        }
+    }
+}
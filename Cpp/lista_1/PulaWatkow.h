@@ -0,0 +1,35 @@
+#ifndef PULAWATKOW_H
+#define PULAWATKOW_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Stała liczba wątków roboczych i wspólna kolejka zadań.
+// czekaj() wraca, gdy wszystkie dodane dotąd zadania są zakończone.
+class PulaWatkow {
+public:
+    explicit PulaWatkow(int liczbaWatkow);
+    ~PulaWatkow();
+    void dodaj(std::function<void()> zadanie);
+    void czekaj();
+    int liczbaWatkow() const;
+
+    static int domyslnaLiczbaWatkow();
+
+private:
+    void petla();
+
+    std::vector<std::thread> watki;
+    std::deque<std::function<void()>> kolejka;
+    std::mutex blokada;
+    std::condition_variable jestZadanie;
+    std::condition_variable wszystkoGotowe;
+    int niezakonczone = 0;
+    bool koniec = false;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "PulaWierszy.h"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+using namespace std;
+
+static const int NAJMNIEJSZA_KLASA = 6;
+
+PulaWierszy::PulaWierszy(size_t rozmiarBloku)
+    : rozmiarBloku(bit_ceil(max(rozmiarBloku, (size_t) 1 << NAJMNIEJSZA_KLASA))) {}
+
+PulaWierszy::~PulaWierszy() {
+    while (bloki) {
+        void* poprzedni = *(void**) bloki;
+        ::operator delete(bloki);
+        bloki = poprzedni;
+    }
+}
+
+PulaWierszy::Uzycie::Uzycie(PulaWierszy& pula) : poprzednia(biezaca) {
+    biezaca = &pula;
+}
+
+PulaWierszy::Uzycie::~Uzycie() {
+    biezaca = poprzednia;
+}
+
+void* PulaWierszy::przydzielBajty(size_t bajty) {
+    PulaWierszy* pula = biezaca;
+    if (!pula) {
+        Naglowek* naglowek = (Naglowek*) ::operator new(sizeof(Naglowek) + bajty);
+        naglowek->pula = nullptr;
+        return naglowek + 1;
+    }
+
+    ++pula->przydzialy;
+    int klasa = max((int) bit_width(sizeof(Naglowek) + bajty - 1), NAJMNIEJSZA_KLASA);
+    Naglowek* naglowek = pula->wytnij(klasa);
+    naglowek->pula = pula;
+    naglowek->klasa = klasa;
+    return naglowek + 1;
+}
+
+void PulaWierszy::zwolnij(void* bufor) {
+    if (!bufor) {
+        return;
+    }
+    Naglowek* naglowek = (Naglowek*) bufor - 1;
+    PulaWierszy* pula = naglowek->pula;
+    if (!pula) {
+        ::operator delete(naglowek);
+        return;
+    }
+    ++pula->zwolnienia;
+    *(Naglowek**) bufor = pula->listyWolnych[naglowek->klasa];
+    pula->listyWolnych[naglowek->klasa] = naglowek;
+}
+
+// Bufor klasy z listy wolnych, a gdy jej brak - z bieżącego bloku. Bufor większy niż blok dostaje
+// własny blok; resztka bloku, która się już nie mieści, trafia na listy wolnych mniejszych klas.
+PulaWierszy::Naglowek* PulaWierszy::wytnij(int klasa) {
+    if (Naglowek* wolny = listyWolnych[klasa]) {
+        listyWolnych[klasa] = *(Naglowek**) (wolny + 1);
+        ++ponownieUzyte;
+        return wolny;
+    }
+
+    size_t rozmiar = (size_t) 1 << klasa;
+    if (rozmiar > rozmiarBloku) {
+        return (Naglowek*) nowyBlok(rozmiar);
+    }
+    if (rozmiar > pozostalo) {
+        while (pozostalo >= ((size_t) 1 << NAJMNIEJSZA_KLASA)) {
+            int k = bit_width(pozostalo) - 1;
+            Naglowek* resztka = (Naglowek*) wolne;
+            *(Naglowek**) (resztka + 1) = listyWolnych[k];
+            listyWolnych[k] = resztka;
+            wolne += (size_t) 1 << k;
+            pozostalo -= (size_t) 1 << k;
+        }
+        wolne = nowyBlok(rozmiarBloku);
+        pozostalo = rozmiarBloku;
+    }
+    Naglowek* naglowek = (Naglowek*) wolne;
+    wolne += rozmiar;
+    pozostalo -= rozmiar;
+    return naglowek;
+}
+
+// Blok poprzedzony 16 bajtami na wskaźnik do poprzedniego bloku, żeby dane były wyrównane tak jak bufory.
+char* PulaWierszy::nowyBlok(size_t bajty) {
+    char* blok = (char*) ::operator new(sizeof(Naglowek) + bajty);
+    *(void**) blok = bloki;
+    bloki = blok;
+    ++alokacjeBlokow;
+    bajtyBlokow += sizeof(Naglowek) + bajty;
+    return blok + sizeof(Naglowek);
+}
+
+size_t PulaWierszy::zajetaPamiec() const {
+    return bajtyBlokow;
+}
@@ -0,0 +1,79 @@
+#ifndef PULAWIERSZY_H
+#define PULAWIERSZY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+// Arena buforów wierszy z klasami rozmiarów. Nowe bufory wycinane są z dużych bloków,
+// a zwolnione trafiają na listę wolnych swojej klasy i dostaje je następny wiersz tej klasy.
+// Klasa to potęga dwójki bajtów, czyli dla danego typu elementu przedział n o wspólnym
+// najstarszym bicie liczby przechowywanych elementów.
+// Wiersze biorą bufory z puli, gdy powstają w zasięgu PulaWierszy::Uzycie w tym samym wątku,
+// a poza nim ze sterty. Destruktor puli zwalnia wszystkie bloki naraz, więc wiersze z puli
+// muszą zniknąć przed nią.
+class PulaWierszy {
+public:
+    explicit PulaWierszy(size_t rozmiarBloku = 1 << 20);
+    PulaWierszy(const PulaWierszy&) = delete;
+    PulaWierszy& operator=(const PulaWierszy&) = delete;
+    ~PulaWierszy();
+
+    // Pula jest bieżąca dla wątku do końca zasięgu, potem wraca poprzednia.
+    class Uzycie {
+    public:
+        explicit Uzycie(PulaWierszy& pula);
+        Uzycie(const Uzycie&) = delete;
+        Uzycie& operator=(const Uzycie&) = delete;
+        ~Uzycie();
+
+    private:
+        PulaWierszy* poprzednia;
+    };
+
+    // Bufor na liczba elementów z bieżącej puli albo ze sterty; zwalnia się go przez zwolnij.
+    template <typename T>
+    static T* przydziel(size_t liczba) {
+        T* bufor = (T*) przydzielBajty(liczba * sizeof(T));
+        if constexpr (!std::is_trivially_default_constructible_v<T>) {
+            std::uninitialized_default_construct_n(bufor, liczba);
+        }
+        return bufor;
+    }
+
+    // Bufor wraca tam, skąd pochodzi (do swojej puli albo na stertę); nullptr jest pomijany.
+    static void zwolnij(void* bufor);
+    size_t zajetaPamiec() const;
+
+    // alokacjeBlokow to jedyne wywołania sterty przez pulę, więc w stanie ustalonym nie rośnie.
+    long long przydzialy = 0;
+    long long ponownieUzyte = 0;
+    long long zwolnienia = 0;
+    long long alokacjeBlokow = 0;
+
+private:
+    // Przed każdym buforem; 16 bajtów, żeby bufor był wyrównany dla unsigned __int128.
+    struct alignas(16) Naglowek {
+        PulaWierszy* pula;
+        uint32_t klasa;
+    };
+
+    static void* przydzielBajty(size_t bajty);
+    Naglowek* wytnij(int klasa);
+    char* nowyBlok(size_t bajty);
+
+    static const int LICZBA_KLAS = 64;
+    inline static thread_local PulaWierszy* biezaca = nullptr;
+
+    size_t rozmiarBloku;
+    // Bloki tworzą listę: pierwsze słowo bloku wskazuje poprzedni blok.
+    void* bloki = nullptr;
+    char* wolne = nullptr;
+    size_t pozostalo = 0;
+    size_t bajtyBlokow = 0;
+    // Pierwsze słowo wolnego bufora wskazuje następny wolny nagłówek tej klasy.
+    Naglowek* listyWolnych[LICZBA_KLAS] = {};
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "RownoleglyTrojkat.h"
+#include "PlanistaZKradzieza.h"
+#include "JadroWiersza.h"
+#include "LiczbaModulo.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+template <typename T>
+void RownoleglyTrojkat<T>::zbuduj(T* dane, int liczbaWierszy, int liczbaWatkow) {
+    if (liczbaWierszy <= 0) {
+        return;
+    }
+    const long long szerokosc = max<long long>(DLUGOSC_KAFELKA / sizeof(T), 1);
+
+    // Kafelki wiersza r mają numery poczatekWiersza[r] + j; zadanie to r << 32 | j.
+    vector<long long> poczatekWiersza(liczbaWierszy + 1, 0);
+    for (int r = 0; r < liczbaWierszy; ++r) {
+        poczatekWiersza[r + 1] = poczatekWiersza[r] + (r + szerokosc) / szerokosc;
+    }
+    long long liczbaKafelkow = poczatekWiersza[liczbaWierszy];
+
+    // Liczba jeszcze niegotowych rodziców: kafelek j-1 (dla j > 0) i kafelek j, jeśli istnieje w wierszu r-1.
+    unique_ptr<atomic<uint8_t>[]> brakujacy(new atomic<uint8_t>[liczbaKafelkow]);
+    for (int r = 0; r < liczbaWierszy; ++r) {
+        for (long long j = 0; j < poczatekWiersza[r + 1] - poczatekWiersza[r]; ++j) {
+            int rodzice = r == 0 ? 0 : (j > 0) + (j * szerokosc <= r - 1);
+            brakujacy[poczatekWiersza[r] + j].store(rodzice, memory_order_relaxed);
+        }
+    }
+
+    PlanistaZKradzieza planista(liczbaWatkow);
+    auto zglosGotowy = [&](int r, long long j, int watek) {
+        if (r + 1 >= liczbaWierszy) {
+            return;
+        }
+        for (long long dziecko : {j, j + 1}) {
+            if (dziecko * szerokosc > r + 1) {
+                continue;
+            }
+            if (brakujacy[poczatekWiersza[r + 1] + dziecko].fetch_sub(1, memory_order_acq_rel) == 1) {
+                planista.dodaj(watek, (long long) (r + 1) << 32 | dziecko);
+            }
+        }
+    };
+
+    planista.uruchom({0}, liczbaKafelkow, [&](long long zadanie, int watek) {
+        int r = (int) (zadanie >> 32);
+        long long j = zadanie & 0xffffffff;
+        T* biezacy = dane + (size_t) r * (r + 1) / 2;
+        int od = (int) (j * szerokosc);
+        int doIndeksu = (int) min<long long>(od + szerokosc, r + 1);
+
+        if (od == 0) {
+            biezacy[0] = T(1);
+            ++od;
+        }
+        if (doIndeksu == r + 1 && od <= r) {
+            biezacy[r] = T(1);
+            --doIndeksu;
+        }
+        if (od < doIndeksu) {
+            JadroWiersza::sumujSasiednie(dane + (size_t) (r - 1) * r / 2, biezacy, od, doIndeksu);
+        }
+        zglosGotowy(r, j, watek);
+    });
+}
+
+template class RownoleglyTrojkat<int>;
+template class RownoleglyTrojkat<uint64_t>;
+template class RownoleglyTrojkat<unsigned __int128>;
+template class RownoleglyTrojkat<LiczbaModulo>;
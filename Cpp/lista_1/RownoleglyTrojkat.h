@@ -0,0 +1,15 @@
+#ifndef ROWNOLEGLYTROJKAT_H
+#define ROWNOLEGLYTROJKAT_H
+
+// Budowa wierszy 0..N-1 w układzie trójkątnym z TrojkatWPliku (wiersz r od elementu
+// r(r+1)/2) frontem fali: wiersz dzielony jest na kafelki po DLUGOSC_KAFELKA bajtów,
+// a kafelek j wiersza r rusza, gdy gotowe są kafelki j-1 i j wiersza r-1.
+template <typename T>
+class RownoleglyTrojkat {
+public:
+    static void zbuduj(T* dane, int liczbaWierszy, int liczbaWatkow);
+
+    static const int DLUGOSC_KAFELKA = 16 * 1024;
+};
+
+#endif
@@ -0,0 +1,163 @@
+#include "Serwer.h"
+#include "LiczbaModulo.h"
+#include "DuzaLiczba.h"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+
+template <typename T>
+Serwer<T>::Serwer(size_t limitPamieci) : pamiec(limitPamieci) {}
+
+template <typename T>
+void Serwer<T>::obsluz(FILE* wejscie, FILE* wyjscie) {
+    char* bufor = nullptr;
+    size_t pojemnosc = 0;
+    ssize_t dlugosc;
+    while ((dlugosc = getline(&bufor, &pojemnosc, wejscie)) != -1) {
+        string zapytanie(bufor, dlugosc);
+        if (zapytanie.find_first_not_of(" \t\r\n") == string::npos) {
+            continue;
+        }
+        odpowiedz(zapytanie, wyjscie);
+        fflush(wyjscie);
+    }
+    free(bufor);
+}
+
+template <typename T>
+void Serwer<T>::odpowiedz(const string& zapytanie, FILE* wyjscie) {
+    istringstream strumien(zapytanie);
+    string id, napisN;
+    strumien >> id >> napisN;
+
+    if (napisN == "statystyki") {
+        fprintf(wyjscie, "%s trafienia: %lld chybienia: %lld wyrzucenia: %lld wiersze: %zu pamiec: %zu\n",
+                id.c_str(), pamiec.trafienia, pamiec.chybienia, pamiec.wyrzucenia,
+                pamiec.liczbaWierszy(), pamiec.zajetaPamiec());
+        fprintf(wyjscie, "%s przydzialy: %lld ponownie: %lld zwolnienia: %lld bloki: %lld pula: %zu\n",
+                id.c_str(), pamiec.pula.przydzialy, pamiec.pula.ponownieUzyte, pamiec.pula.zwolnienia,
+                pamiec.pula.alokacjeBlokow, pamiec.pula.zajetaPamiec());
+        fprintf(wyjscie, "%s koniec\n", id.c_str());
+        return;
+    }
+
+    try {
+        int n;
+        try {
+            n = stoi(napisN);
+        } catch (const exception& e) {
+            throw invalid_argument(napisN + " - nieprawidłowa dana");
+        }
+        if (n < 0) {
+            throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+        }
+        WierszTrojkataPascala<T>& w = pamiec.wiersz(n);
+
+        string napisM;
+        bool saElementy = false;
+        while (strumien >> napisM) {
+            saElementy = true;
+            // "a..b" to suma elementów od a do b włącznie, tak jak w trybie wiersza.
+            size_t kropki = napisM.find("..");
+            if (kropki != string::npos) {
+                int a, b;
+                try {
+                    a = stoi(napisM.substr(0, kropki));
+                    b = stoi(napisM.substr(kropki + 2));
+                } catch (const exception& e) {
+                    fprintf(wyjscie, "%s %s - nieprawidłowa dana\n", id.c_str(), napisM.c_str());
+                    continue;
+                }
+                try {
+                    string suma = w.napisSumy(a, b);
+                    fprintf(wyjscie, "%s %d..%d - %s\n", id.c_str(), a, b, suma.c_str());
+                } catch (const exception& e) {
+                    fprintf(wyjscie, "%s %s\n", id.c_str(), e.what());
+                }
+                continue;
+            }
+            int m;
+            try {
+                m = stoi(napisM);
+            } catch (const exception& e) {
+                fprintf(wyjscie, "%s %s - nieprawidłowa dana\n", id.c_str(), napisM.c_str());
+                continue;
+            }
+            try {
+                string element = w.napisElementu(m);
+                fprintf(wyjscie, "%s %d - %s\n", id.c_str(), m, element.c_str());
+            } catch (const exception& e) {
+                fprintf(wyjscie, "%s %s\n", id.c_str(), e.what());
+            }
+        }
+
+        if (!saElementy) {
+            string linia = id + " Wiersz " + to_string(n) + ": ";
+            for (int i = 0; i <= n; ++i) {
+                linia += w.napisElementu(i);
+                linia += ' ';
+            }
+            linia += '\n';
+            fwrite(linia.data(), 1, linia.size(), wyjscie);
+        }
+    } catch (const exception& e) {
+        fprintf(wyjscie, "%s %s\n", id.c_str(), e.what());
+    }
+
+    fprintf(wyjscie, "%s koniec\n", id.c_str());
+}
+
+// Połączenia obsługujemy po kolei; klient trzyma jedno połączenie i wysyła w nim wiele zapytań.
+template <typename T>
+void Serwer<T>::nasluchuj(const string& sciezkaGniazda) {
+    signal(SIGPIPE, SIG_IGN);
+    int gniazdo = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (gniazdo < 0) {
+        throw runtime_error(string("socket: ") + strerror(errno));
+    }
+
+    sockaddr_un adres{};
+    adres.sun_family = AF_UNIX;
+    if (sciezkaGniazda.size() >= sizeof(adres.sun_path)) {
+        close(gniazdo);
+        throw invalid_argument(sciezkaGniazda + " - za długa ścieżka gniazda");
+    }
+    strcpy(adres.sun_path, sciezkaGniazda.c_str());
+    unlink(sciezkaGniazda.c_str());
+
+    if (bind(gniazdo, (sockaddr*) &adres, sizeof(adres)) < 0 || listen(gniazdo, 16) < 0) {
+        string blad = strerror(errno);
+        close(gniazdo);
+        throw runtime_error(sciezkaGniazda + ": " + blad);
+    }
+
+    while (true) {
+        int klient = accept(gniazdo, nullptr, nullptr);
+        if (klient < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            string blad = strerror(errno);
+            close(gniazdo);
+            throw runtime_error(string("accept: ") + blad);
+        }
+        FILE* wejscie = fdopen(klient, "r");
+        FILE* wyjscie = fdopen(dup(klient), "w");
+        obsluz(wejscie, wyjscie);
+        fclose(wyjscie);
+        fclose(wejscie);
+    }
+}
+
+template class Serwer<int>;
+template class Serwer<uint64_t>;
+template class Serwer<unsigned __int128>;
+template class Serwer<LiczbaModulo>;
+template class Serwer<DuzaLiczba>;
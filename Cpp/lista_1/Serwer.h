@@ -0,0 +1,24 @@
+#ifndef SERWER_H
+#define SERWER_H
+
+#include <cstdio>
+#include <string>
+#include "PamiecWierszy.h"
+
+// Długo działający proces odpowiadający na zapytania w postaci linii "id n [m | a..b ...]".
+// Bez m odpowiedzią jest "id Wiersz n: ...", z m - po jednej linii "id m - wartość",
+// a z a..b - "id a..b - suma" elementów od a do b włącznie.
+// Każda odpowiedź kończy się linią "id koniec", a wyjście jest opróżniane po każdej.
+// Zapytanie "id statystyki" zwraca liczniki pamięci podręcznej wierszy i jej puli buforów.
+template <typename T>
+class Serwer {
+public:
+    explicit Serwer(size_t limitPamieci);
+    void obsluz(FILE* wejscie, FILE* wyjscie);
+    void odpowiedz(const std::string& zapytanie, FILE* wyjscie);
+    void nasluchuj(const std::string& sciezkaGniazda);
+
+    PamiecWierszy<T> pamiec;
+};
+
+#endif
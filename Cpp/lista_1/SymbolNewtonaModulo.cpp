@@ -0,0 +1,109 @@
+#include "SymbolNewtonaModulo.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+// Dzielenie próbne do pierwiastka: p < 2^32, więc najwyżej 2^16 dzieleń.
+bool SymbolNewtonaModulo::czyPierwsza(uint32_t p) {
+    if (p < 2) {
+        return false;
+    }
+    for (uint64_t d = 2; d * d <= p; ++d) {
+        if (p % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SymbolNewtonaModulo::SymbolNewtonaModulo(uint32_t p) : p(p) {
+    if (p >= (1u << 31) || !czyPierwsza(p)) {
+        throw invalid_argument(to_string(p) + " - moduł musi być liczbą pierwszą mniejszą od 2^31");
+    }
+    if (p > NAJWIEKSZA_TABLICA) {
+        return;
+    }
+
+    silnie.resize(p);
+    odwrotneSilnie.resize(p);
+    silnie[0] = 1;
+    for (uint32_t i = 1; i < p; ++i) {
+        silnie[i] = (uint64_t) silnie[i - 1] * i % p;
+    }
+    odwrotneSilnie[p - 1] = potega(silnie[p - 1], p - 2);
+    for (uint32_t i = p - 1; i > 0; --i) {
+        odwrotneSilnie[i - 1] = (uint64_t) odwrotneSilnie[i] * i % p;
+    }
+}
+
+// Tablice dla ostatnio używanych modułów, żeby seria zapytań z tym samym p budowała je raz.
+const SymbolNewtonaModulo& SymbolNewtonaModulo::dlaModulu(uint32_t p) {
+    thread_local map<uint32_t, unique_ptr<SymbolNewtonaModulo>> tablice;
+    auto it = tablice.find(p);
+    if (it != tablice.end()) {
+        return *it->second;
+    }
+    if (tablice.size() >= PAMIETANE_MODULY) {
+        tablice.clear();
+    }
+    return *(tablice[p] = make_unique<SymbolNewtonaModulo>(p));
+}
+
+uint32_t SymbolNewtonaModulo::oblicz(unsigned long long n, unsigned long long k) const {
+    if (k > n) {
+        return 0;
+    }
+    uint64_t wynik = 1 % p;
+    while (k > 0 && wynik != 0) {
+        uint32_t cyfraN = n % p;
+        uint32_t cyfraK = k % p;
+        if (cyfraK > cyfraN) {
+            return 0;
+        }
+        wynik = wynik * symbolCyfry(cyfraN, cyfraK) % p;
+        n /= p;
+        k /= p;
+    }
+    return wynik;
+}
+
+// Odwrotność x (niepodzielnego przez p) - z tablic, gdy są, inaczej z małego twierdzenia Fermata.
+uint32_t SymbolNewtonaModulo::odwrotnosc(uint32_t x) const {
+    x %= p;
+    if (!silnie.empty() && x != 0) {
+        return (uint64_t) silnie[x - 1] * odwrotneSilnie[x] % p;
+    }
+    return potega(x, p - 2);
+}
+
+uint32_t SymbolNewtonaModulo::symbolCyfry(uint32_t n, uint32_t k) const {
+    if (!silnie.empty()) {
+        return (uint64_t) silnie[n] * odwrotneSilnie[k] % p * odwrotneSilnie[n - k] % p;
+    }
+
+    k = min(k, n - k);
+    uint64_t licznik = 1;
+    uint64_t mianownik = 1;
+    for (uint32_t i = 0; i < k; ++i) {
+        licznik = licznik * (n - i) % p;
+        mianownik = mianownik * (i + 1) % p;
+    }
+    return licznik * potega(mianownik, p - 2) % p;
+}
+
+uint32_t SymbolNewtonaModulo::potega(uint64_t podstawa, uint32_t wykladnik) const {
+    uint64_t wynik = 1 % p;
+    podstawa %= p;
+    while (wykladnik > 0) {
+        if (wykladnik & 1) {
+            wynik = wynik * podstawa % p;
+        }
+        podstawa = podstawa * podstawa % p;
+        wykladnik >>= 1;
+    }
+    return wynik;
+}
@@ -0,0 +1,31 @@
+#ifndef SYMBOLNEWTONAMODULO_H
+#define SYMBOLNEWTONAMODULO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// C(n, k) mod p dla pierwszego p < 2^31 i n do 2^64 - 1.
+// Dla p <= NAJWIEKSZA_TABLICA trzymamy silnie i odwrotności silni 0..p-1, a większe n
+// rozkładamy twierdzeniem Lucasa na cyfry w systemie o podstawie p, więc zapytanie
+// kosztuje O(log_p n). Przy większym p cyfry liczymy iloczynem w O(min(k, n - k)).
+class SymbolNewtonaModulo {
+public:
+    explicit SymbolNewtonaModulo(uint32_t p);
+    uint32_t oblicz(unsigned long long n, unsigned long long k) const;
+    uint32_t odwrotnosc(uint32_t x) const;
+    static const SymbolNewtonaModulo& dlaModulu(uint32_t p);
+    static bool czyPierwsza(uint32_t p);
+    uint32_t p;
+
+    static const uint32_t NAJWIEKSZA_TABLICA = 1u << 22;
+    static const size_t PAMIETANE_MODULY = 8;
+
+private:
+    uint32_t symbolCyfry(uint32_t n, uint32_t k) const;
+    uint32_t potega(uint64_t podstawa, uint32_t wykladnik) const;
+    std::vector<uint32_t> silnie;
+    std::vector<uint32_t> odwrotneSilnie;
+};
+
+#endif
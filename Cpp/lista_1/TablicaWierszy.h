@@ -0,0 +1,43 @@
+#ifndef TABLICAWIERSZY_H
+#define TABLICAWIERSZY_H
+
+#include <array>
+#include <cstdint>
+
+// Wiersze 0..N trójkąta policzone w czasie kompilacji i ułożone jeden za drugim
+// (wiersz n od elementu n(n+1)/2), tak jak w TrojkatWPliku. Leżą w danych tylko do odczytu,
+// więc WierszTrojkataPascala dla małych n tylko wskazuje na swój wiersz (bez alokacji).
+template <typename T, int N>
+class TablicaWierszy {
+public:
+    static constexpr int NAJWIEKSZY = N;
+
+    static constexpr const T* wiersz(int n) {
+        return dane.data() + n * (n + 1) / 2;
+    }
+
+private:
+    static constexpr std::array<T, (N + 1) * (N + 2) / 2> zbuduj() {
+        std::array<T, (N + 1) * (N + 2) / 2> wynik{};
+        for (int n = 0; n <= N; ++n) {
+            T* biezacy = wynik.data() + n * (n + 1) / 2;
+            biezacy[0] = 1;
+            biezacy[n] = 1;
+            for (int i = 1; i < n; ++i) {
+                biezacy[i] = biezacy[i - n - 1] + biezacy[i - n];
+            }
+        }
+        return wynik;
+    }
+
+    static constexpr std::array<T, (N + 1) * (N + 2) / 2> dane = zbuduj();
+};
+
+// Wszystkie wiersze, których elementy mieszczą się w typie (najwiekszyDokladnyWiersz).
+using TablicaInt = TablicaWierszy<int, 33>;
+using TablicaU64 = TablicaWierszy<uint64_t, 67>;
+
+static_assert(TablicaU64::wiersz(67)[33] == 14226520737620288370ULL);
+static_assert(TablicaInt::wiersz(33)[16] == 1166803110);
+
+#endif
@@ -0,0 +1,79 @@
+#include "TrojkatWPliku.h"
+#include "JadroWiersza.h"
+#include "LiczbaModulo.h"
+#include "RownoleglyTrojkat.h"
+#include "WierszTrojkataPascala.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace std;
+
+template <typename T>
+T* TrojkatWPliku<T>::wiersz(void* dane, int r) {
+    return (T*) dane + (size_t) r * (r + 1) / 2;
+}
+
+template <typename T>
+uint64_t TrojkatWPliku<T>::zapisz(const string& sciezka, int liczbaWierszy, int liczbaWatkow) {
+    if (liczbaWierszy < 0) {
+        throw invalid_argument(to_string(liczbaWierszy) + " - nieprawidłowa liczba wierszy");
+    }
+    int ostatniDokladny = WierszTrojkataPascala<T>::najwiekszyDokladnyWiersz();
+    if (ostatniDokladny >= 0 && liczbaWierszy - 1 > ostatniDokladny) {
+        throw overflow_error(to_string(liczbaWierszy - 1) + " - wynik przekracza zakres typu (ostatni dokładny wiersz: "
+                             + to_string(ostatniDokladny) + ")");
+    }
+
+    uint64_t rozmiarDanych = (uint64_t) liczbaWierszy * (liczbaWierszy + 1) / 2 * sizeof(T);
+    uint64_t rozmiarPliku = sizeof(NaglowekTrojkata) + rozmiarDanych;
+
+    int plik = open(sciezka.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (plik < 0) {
+        throw runtime_error(sciezka + ": " + strerror(errno));
+    }
+    if (ftruncate(plik, rozmiarPliku) < 0) {
+        string blad = strerror(errno);
+        close(plik);
+        throw runtime_error(sciezka + ": " + blad);
+    }
+    void* mapa = mmap(nullptr, rozmiarPliku, PROT_READ | PROT_WRITE, MAP_SHARED, plik, 0);
+    close(plik);
+    if (mapa == MAP_FAILED) {
+        throw runtime_error(sciezka + ": " + strerror(errno));
+    }
+
+    NaglowekTrojkata* naglowek = (NaglowekTrojkata*) mapa;
+    memcpy(naglowek->sygnatura, "TROJKAT", 8);
+    naglowek->wersja = 1;
+    naglowek->rozmiarElementu = sizeof(T);
+    naglowek->liczbaWierszy = liczbaWierszy;
+    naglowek->modul = is_same_v<T, LiczbaModulo> ? LiczbaModulo::modul : 0;
+    naglowek->przesuniecieDanych = sizeof(NaglowekTrojkata);
+
+    void* dane = (char*) mapa + sizeof(NaglowekTrojkata);
+    if (liczbaWatkow > 1) {
+        RownoleglyTrojkat<T>::zbuduj((T*) dane, liczbaWierszy, liczbaWatkow);
+    } else {
+        // Jednym wątkiem: wiersz r to kopia wiersza r-1 z dopisaną jedynką, przesunięta jądrem w miejscu.
+        for (int r = 0; r < liczbaWierszy; ++r) {
+            T* biezacy = wiersz(dane, r);
+            if (r > 0) {
+                memcpy(biezacy, wiersz(dane, r - 1), r * sizeof(T));
+            }
+            biezacy[r] = T(1);
+            JadroWiersza::dodajSasiednie(biezacy, r);
+        }
+    }
+
+    munmap(mapa, rozmiarPliku);
+    return rozmiarPliku;
+}
+
+template class TrojkatWPliku<int>;
+template class TrojkatWPliku<uint64_t>;
+template class TrojkatWPliku<unsigned __int128>;
+template class TrojkatWPliku<LiczbaModulo>;
@@ -0,0 +1,33 @@
+#ifndef TROJKATWPLIKU_H
+#define TROJKATWPLIKU_H
+
+#include <cstdint>
+#include <string>
+
+// Plik z wierszami 0..N-1 ułożonymi jeden za drugim (N(N+1)/2 elementów, wiersz r
+// zaczyna się od elementu r(r+1)/2), poprzedzony 64-bajtowym nagłówkiem.
+// Wszystkie pola i elementy są little-endian, elementy mają stałą szerokość,
+// więc odbiorca może zmapować plik i czytać dane bez parsowania.
+struct NaglowekTrojkata {
+    char sygnatura[8];
+    uint32_t wersja;
+    uint32_t rozmiarElementu;
+    uint64_t liczbaWierszy;
+    uint64_t modul;
+    uint64_t przesuniecieDanych;
+    uint8_t zarezerwowane[24];
+};
+
+static_assert(sizeof(NaglowekTrojkata) == 64);
+
+// Zapis przez mmap: wiersze liczone są od razu w zmapowanym pliku,
+// przy więcej niż jednym wątku - frontem fali (RownoleglyTrojkat).
+// Typy stałej szerokości: int (int32), uint64_t, unsigned __int128, LiczbaModulo (uint32).
+template <typename T>
+class TrojkatWPliku {
+public:
+    static uint64_t zapisz(const std::string& sciezka, int liczbaWierszy, int liczbaWatkow = 1);
+    static T* wiersz(void* dane, int r);
+};
+
+#endif
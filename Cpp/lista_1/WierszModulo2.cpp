@@ -0,0 +1,136 @@
+#include "WierszModulo2.h"
+#include "PulaWierszy.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+WierszTrojkataPascala<bool>::WierszTrojkataPascala(int n, Przechowywanie przechowywanie)
+    : przechowywanie(przechowywanie) {
+    if (n < 0) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    size = n + 1;
+    liczbaSlow = n / 64 + 1;
+    slowa = PulaWierszy::przydziel<uint64_t>(liczbaSlow);
+    fill_n(slowa, liczbaSlow, 0);
+    slowa[0] = 1;
+    przesunWiersz(0, n);
+}
+
+WierszTrojkataPascala<bool>::WierszTrojkataPascala(const WierszTrojkataPascala& poprzedni, int n)
+    : przechowywanie(poprzedni.przechowywanie) {
+    if (n < poprzedni.size - 1) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    size = n + 1;
+    liczbaSlow = n / 64 + 1;
+    slowa = PulaWierszy::przydziel<uint64_t>(liczbaSlow);
+    fill_n(slowa, liczbaSlow, 0);
+    copy_n(poprzedni.slowa, poprzedni.liczbaSlow, slowa);
+    przesunWiersz(poprzedni.size - 1, n);
+}
+
+WierszTrojkataPascala<bool>::WierszTrojkataPascala(WierszTrojkataPascala&& inny) noexcept
+    : slowa(exchange(inny.slowa, nullptr)), liczbaSlow(exchange(inny.liczbaSlow, 0)), size(exchange(inny.size, 0)),
+      przechowywanie(inny.przechowywanie), sumy(exchange(inny.sumy, nullptr)) {}
+
+WierszTrojkataPascala<bool>& WierszTrojkataPascala<bool>::operator=(WierszTrojkataPascala&& inny) noexcept {
+    if (this != &inny) {
+        PulaWierszy::zwolnij(slowa);
+        PulaWierszy::zwolnij(sumy);
+        slowa = exchange(inny.slowa, nullptr);
+        liczbaSlow = exchange(inny.liczbaSlow, 0);
+        size = exchange(inny.size, 0);
+        przechowywanie = inny.przechowywanie;
+        sumy = exchange(inny.sumy, nullptr);
+    }
+    return *this;
+}
+
+WierszTrojkataPascala<bool>::~WierszTrojkataPascala() {
+    PulaWierszy::zwolnij(slowa);
+    PulaWierszy::zwolnij(sumy);
+}
+
+span<const uint64_t> WierszTrojkataPascala<bool>::widok() const {
+    return span<const uint64_t>(slowa, liczbaSlow);
+}
+
+bool WierszTrojkataPascala<bool>::MtyElementWiersza(int m) {
+    if (m < 0 || m >= size) {
+        throw out_of_range(to_string(m) + " - liczba spoza zakresu");
+    }
+    return (slowa[m / 64] >> (m % 64)) & 1;
+}
+
+string WierszTrojkataPascala<bool>::napisElementu(int m) {
+    return MtyElementWiersza(m) ? "1" : "0";
+}
+
+// Prefiksowy XOR w słowie w sześciu krokach, potem odwrócenie, jeśli poprzednie słowa miały nieparzystą sumę.
+void WierszTrojkataPascala<bool>::zbudujSumy() {
+    sumy = PulaWierszy::przydziel<uint64_t>(liczbaSlow);
+    uint64_t parzystosc = 0;
+    for (int w = 0; w < liczbaSlow; ++w) {
+        uint64_t x = slowa[w];
+        for (int przesuniecie = 1; przesuniecie < 64; przesuniecie <<= 1) {
+            x ^= x << przesuniecie;
+        }
+        x ^= -parzystosc;
+        sumy[w] = x;
+        parzystosc = x >> 63;
+    }
+}
+
+bool WierszTrojkataPascala<bool>::sumaZakresu(int a, int b) {
+    MtyElementWiersza(a);
+    MtyElementWiersza(b);
+    if (a > b) {
+        throw invalid_argument(to_string(a) + ".." + to_string(b) + " - nieprawidłowy zakres");
+    }
+    if (!sumy) {
+        zbudujSumy();
+    }
+    bool doB = (sumy[b / 64] >> (b % 64)) & 1;
+    bool przedA = a > 0 && ((sumy[(a - 1) / 64] >> ((a - 1) % 64)) & 1);
+    return doB != przedA;
+}
+
+string WierszTrojkataPascala<bool>::napisSumy(int a, int b) {
+    return sumaZakresu(a, b) ? "1" : "0";
+}
+
+size_t WierszTrojkataPascala<bool>::zajetaPamiec() const {
+    return sizeof(uint64_t) * liczbaSlow * (sumy ? 2 : 1);
+}
+
+bool WierszTrojkataPascala<bool>::nieparzysty(unsigned long long n, unsigned long long m) {
+    if (m > n) {
+        throw out_of_range(to_string(m) + " - liczba spoza zakresu");
+    }
+    return (m & ~n) == 0;
+}
+
+// Słowa przechodzimy od najstarszego, więc czytane młodsze słowa mają jeszcze stare wartości.
+void WierszTrojkataPascala<bool>::przesunWiersz(int z, int n) {
+    // Dla n - z >= 2^30 podwajanie int przepełniłoby się przed wyjściem z pętli, więc liczymy na 64 bitach.
+    uint64_t roznica = (uint64_t) n - z;
+    int64_t stopien = z;
+    for (uint64_t przesuniecie = 1; przesuniecie <= roznica; przesuniecie <<= 1) {
+        if (!(roznica & przesuniecie)) {
+            continue;
+        }
+        stopien += przesuniecie;
+        int64_t slowo = przesuniecie / 64;
+        int bit = przesuniecie % 64;
+        for (int64_t w = stopien / 64; w >= slowo; --w) {
+            uint64_t przesuniete = slowa[w - slowo] << bit;
+            if (bit && w - slowo > 0) {
+                przesuniete |= slowa[w - slowo - 1] >> (64 - bit);
+            }
+            slowa[w] ^= przesuniete;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef WIERSZMODULO2_H
+#define WIERSZMODULO2_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include "WierszTrojkataPascala.h"
+
+// Wiersz modulo 2 (trójkąt Sierpińskiego): bit m % 64 słowa m / 64 to C(n, m) mod 2.
+// Nad GF(2) (1 + x)^d to iloczyn (1 + x^(2^b)) po bitach b liczby d, więc przejście
+// o d wierszy to popcount(d) przebiegów wiersz ^= wiersz << 2^b, po 64 elementy na słowo.
+// Cały wiersz zajmuje n / 8 bajtów, więc tryb polowa niczego tu nie oszczędza i jest ignorowany.
+template <>
+class WierszTrojkataPascala<bool> {
+public:
+    explicit WierszTrojkataPascala(int n, Przechowywanie przechowywanie = Przechowywanie::caly);
+    WierszTrojkataPascala(const WierszTrojkataPascala& poprzedni, int n);
+    WierszTrojkataPascala(const WierszTrojkataPascala&) = delete;
+    WierszTrojkataPascala& operator=(const WierszTrojkataPascala&) = delete;
+    WierszTrojkataPascala(WierszTrojkataPascala&& inny) noexcept;
+    WierszTrojkataPascala& operator=(WierszTrojkataPascala&& inny) noexcept;
+    ~WierszTrojkataPascala();
+    // Spakowane słowa wiersza (bit m % 64 słowa m / 64) bez kopiowania.
+    std::span<const uint64_t> widok() const;
+    bool MtyElementWiersza(int m);
+    std::string napisElementu(int m);
+    bool sumaZakresu(int a, int b);
+    std::string napisSumy(int a, int b);
+    size_t zajetaPamiec() const;
+    // Lucas dla p = 2: C(n, m) jest nieparzyste wtedy i tylko wtedy, gdy bity m są podzbiorem bitów n.
+    static bool nieparzysty(unsigned long long n, unsigned long long m);
+    uint64_t* slowa = nullptr;
+    int liczbaSlow;
+    int size;
+    Przechowywanie przechowywanie;
+    // Bit m to parzystość sumy elementów 0..m, liczona przy pierwszym sumaZakresu.
+    uint64_t* sumy = nullptr;
+
+private:
+    void zbudujSumy();
+    void przesunWiersz(int z, int n);
+};
+
+#endif
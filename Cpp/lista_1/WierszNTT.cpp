@@ -0,0 +1,220 @@
+#include "WierszNTT.h"
+#include "SymbolNewtonaModulo.h"
+#include <algorithm>
+#include <bit>
+
+using namespace std;
+
+// Mnożenie w postaci Montgomery'ego z R = 2^32; p < 2^31, więc redukcja nie przepełnia uint64_t.
+struct Montgomery {
+    explicit Montgomery(uint32_t p) : p(p) {
+        uint32_t odwrotnosc = p;
+        for (int i = 0; i < 5; ++i) {
+            odwrotnosc *= 2 - p * odwrotnosc;
+        }
+        minusOdwrotnosc = -odwrotnosc;
+        r2 = (uint32_t) (((unsigned __int128) 1 << 64) % p);
+    }
+
+    uint32_t redukuj(uint64_t x) const {
+        uint32_t m = (uint32_t) x * minusOdwrotnosc;
+        uint32_t t = (uint32_t) ((x + (uint64_t) m * p) >> 32);
+        return t >= p ? t - p : t;
+    }
+
+    uint32_t mnoz(uint32_t a, uint32_t b) const {
+        return redukuj((uint64_t) a * b);
+    }
+
+    uint32_t naPostac(uint32_t a) const {
+        return mnoz(a, r2);
+    }
+
+    uint32_t zPostaci(uint32_t a) const {
+        return redukuj(a);
+    }
+
+    uint32_t potega(uint32_t podstawa, uint64_t wykladnik) const {
+        uint32_t wynik = naPostac(1);
+        for (; wykladnik; wykladnik >>= 1) {
+            if (wykladnik & 1) {
+                wynik = mnoz(wynik, podstawa);
+            }
+            podstawa = mnoz(podstawa, podstawa);
+        }
+        return wynik;
+    }
+
+    uint32_t p;
+    uint32_t minusOdwrotnosc;
+    uint32_t r2;
+};
+
+// Największe 2^s dzielące p - 1, czyli największy rozmiar transformaty.
+static uint64_t najwiekszaTransformata(uint32_t p) {
+    return (uint64_t) (p - 1) & -(uint64_t) (p - 1);
+}
+
+// Pierwiastek pierwotny modulo p: g^((p - 1) / q) != 1 dla każdego pierwszego dzielnika q liczby p - 1.
+static uint32_t pierwiastekPierwotny(const Montgomery& m) {
+    vector<uint32_t> dzielniki;
+    uint32_t reszta = m.p - 1;
+    for (uint32_t d = 2; (uint64_t) d * d <= reszta; ++d) {
+        if (reszta % d == 0) {
+            dzielniki.push_back(d);
+            while (reszta % d == 0) {
+                reszta /= d;
+            }
+        }
+    }
+    if (reszta > 1) {
+        dzielniki.push_back(reszta);
+    }
+    for (uint32_t g = 2;; ++g) {
+        uint32_t gM = m.naPostac(g);
+        bool pierwotny = true;
+        for (uint32_t q : dzielniki) {
+            pierwotny = pierwotny && m.zPostaci(m.potega(gM, (m.p - 1) / q)) != 1;
+        }
+        if (pierwotny) {
+            return gM;
+        }
+    }
+}
+
+// Transformata w miejscu na wartościach w postaci Montgomery'ego; rozmiar to potęga dwójki.
+static void ntt(vector<uint32_t>& a, const Montgomery& m, uint32_t pierwiastek, bool odwrotna) {
+    size_t rozmiar = a.size();
+    for (size_t i = 1, j = 0; i < rozmiar; ++i) {
+        size_t bit = rozmiar >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            swap(a[i], a[j]);
+        }
+    }
+
+    vector<uint32_t> potegi(rozmiar / 2);
+    for (size_t dlugosc = 2; dlugosc <= rozmiar; dlugosc <<= 1) {
+        uint32_t krok = m.potega(pierwiastek, (m.p - 1) / dlugosc);
+        if (odwrotna) {
+            krok = m.potega(krok, m.p - 2);
+        }
+        size_t polowa = dlugosc / 2;
+        potegi[0] = m.naPostac(1);
+        for (size_t j = 1; j < polowa; ++j) {
+            potegi[j] = m.mnoz(potegi[j - 1], krok);
+        }
+        for (size_t i = 0; i < rozmiar; i += dlugosc) {
+            for (size_t j = 0; j < polowa; ++j) {
+                uint32_t u = a[i + j];
+                uint32_t v = m.mnoz(a[i + j + polowa], potegi[j]);
+                a[i + j] = u + v >= m.p ? u + v - m.p : u + v;
+                a[i + j + polowa] = u >= v ? u - v : u + m.p - v;
+            }
+        }
+    }
+
+    if (odwrotna) {
+        uint32_t odwrotnyRozmiar = m.potega(m.naPostac((uint32_t) (rozmiar % m.p)), m.p - 2);
+        for (uint32_t& x : a) {
+            x = m.mnoz(x, odwrotnyRozmiar);
+        }
+    }
+}
+
+// Kwadrat wielomianu; krótkie mnożymy szkolnie, dłuższe przez NTT.
+static vector<uint32_t> kwadrat(const vector<uint32_t>& a, const Montgomery& m, uint32_t pierwiastek) {
+    size_t dlugoscWyniku = 2 * a.size() - 1;
+    if (a.size() < 64) {
+        vector<uint64_t> wynik(dlugoscWyniku, 0);
+        for (size_t i = 0; i < a.size(); ++i) {
+            for (size_t j = 0; j < a.size(); ++j) {
+                wynik[i + j] = (wynik[i + j] + (uint64_t) a[i] * a[j]) % m.p;
+            }
+        }
+        return vector<uint32_t>(wynik.begin(), wynik.end());
+    }
+
+    size_t rozmiar = 1;
+    while (rozmiar < dlugoscWyniku) {
+        rozmiar <<= 1;
+    }
+    vector<uint32_t> f(rozmiar, 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        f[i] = m.naPostac(a[i]);
+    }
+    ntt(f, m, pierwiastek, false);
+    for (uint32_t& x : f) {
+        x = m.mnoz(x, x);
+    }
+    ntt(f, m, pierwiastek, true);
+    f.resize(dlugoscWyniku);
+    for (uint32_t& x : f) {
+        x = m.zPostaci(x);
+    }
+    return f;
+}
+
+// (1 + x)^n mod p dla n < p.
+static vector<uint32_t> potegaDwumianu(uint32_t n, const Montgomery& m, uint32_t pierwiastek) {
+    vector<uint32_t> wynik = {1};
+    for (int bit = 31; bit >= 0; --bit) {
+        if (wynik.size() > 1) {
+            wynik = kwadrat(wynik, m, pierwiastek);
+        }
+        if ((n >> bit) & 1) {
+            wynik.push_back(1);
+            for (size_t i = wynik.size() - 2; i > 0; --i) {
+                wynik[i] = wynik[i] + wynik[i - 1] >= m.p ? wynik[i] + wynik[i - 1] - m.p : wynik[i] + wynik[i - 1];
+            }
+        }
+    }
+    return wynik;
+}
+
+static vector<uint32_t> wierszLucasa(long long n, const Montgomery& m, uint32_t pierwiastek) {
+    if (n < m.p) {
+        return potegaDwumianu((uint32_t) n, m, pierwiastek);
+    }
+    uint32_t r = (uint32_t) (n % m.p);
+    vector<uint32_t> mlodszy = potegaDwumianu(r, m, pierwiastek);
+    vector<uint32_t> starszy = wierszLucasa(n / m.p, m, pierwiastek);
+    vector<uint32_t> wynik(n + 1);
+    for (long long k = 0; k <= n; ++k) {
+        uint32_t cyfra = (uint32_t) (k % m.p);
+        wynik[k] = cyfra <= r ? (uint64_t) mlodszy[cyfra] * starszy[k / m.p] % m.p : 0;
+    }
+    return wynik;
+}
+
+// Po rozbiciu Lucasa potęgujemy tylko do cyfr n w systemie o podstawie p,
+// a transformata musi być dłuższa od każdej z nich.
+bool WierszNTT::obsluguje(uint32_t p, long long n) {
+    if (p < 3 || p >= (1u << 31) || n < 0 || !SymbolNewtonaModulo::czyPierwsza(p)) {
+        return false;
+    }
+    for (; n > 0; n /= p) {
+        if ((uint64_t) (n % p) >= najwiekszaTransformata(p)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Przesunięcie od wiersza z to ~(n - z) * n / 2 dodawań, a NTT ~KOSZT_NTT * n log n.
+bool WierszNTT::szybszyOdDodawania(uint32_t p, long long z, long long n) {
+    if (n < PROG) {
+        return false;
+    }
+    long long dodawania = (n - z) * (n / 2 + 1);
+    long long transformaty = KOSZT_NTT * n * bit_width((uint64_t) n);
+    return dodawania > transformaty && obsluguje(p, n);
+}
+
+vector<uint32_t> WierszNTT::wiersz(long long n, uint32_t p) {
+    Montgomery m(p);
+    return wierszLucasa(n, m, pierwiastekPierwotny(m));
+}
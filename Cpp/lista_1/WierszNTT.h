@@ -0,0 +1,25 @@
+#ifndef WIERSZNTT_H
+#define WIERSZNTT_H
+
+#include <cstdint>
+#include <vector>
+
+// Cały wiersz (1 + x)^n mod p dla pierwszego p = c * 2^s + 1 (np. 998244353, 469762049, 65537).
+// Potęgujemy od najstarszego bitu n: kwadrat wielomianu liczony NTT, a mnożenie przez (1 + x)
+// to jedno przejście. Stopień rośnie dwukrotnie, więc transformaty kosztują razem O(n log n).
+// Dla n >= p działa Lucas: n = q p + r i (1 + x)^n = (1 + x)^r (1 + x^p)^q, a że r < p,
+// to C(n, k) = C(r, k mod p) * C(q, k div p) bez mnożenia wielomianów.
+class WierszNTT {
+public:
+    static bool obsluguje(uint32_t p, long long n);
+    // Czy wiersz n lepiej policzyć przez NTT niż dodawaniem wierszy od gotowego wiersza z.
+    static bool szybszyOdDodawania(uint32_t p, long long z, long long n);
+    static std::vector<uint32_t> wiersz(long long n, uint32_t p);
+
+    // Od tego n wiersz LiczbaModulo liczony jest przez NTT zamiast dodawaniem wierszy.
+    static const int PROG = 1 << 12;
+    // Ile dodawań wiersza kosztuje jeden element transformaty razy log n (zmierzone w benchmark: zmierzNTT).
+    static const int KOSZT_NTT = 200;
+};
+
+#endif
@@ -0,0 +1,39 @@
+#include "WierszPromowany.h"
+
+using namespace std;
+
+WierszPromowany::WierszPromowany(int n, Przechowywanie przechowywanie)
+    : size(n + 1), wiersz(make_unique<WierszTrojkataPascala<int>>(n, przechowywanie, true)) {
+    while (visit([](auto& w) { return w->size; }, wiersz) < size) {
+        promuj(n);
+    }
+}
+
+// Nowy wiersz powstaje, zanim stary zostanie zwolniony, bo jest z niego przepisywany.
+void WierszPromowany::promuj(int n) {
+    wiersz = visit([n](auto& w) -> Wiersze {
+        using Wiersz = typename remove_reference_t<decltype(w)>::element_type;
+        if constexpr (is_same_v<Wiersz, WierszTrojkataPascala<int>>) {
+            return make_unique<WierszTrojkataPascala<uint64_t>>(*w, n, true);
+        } else if constexpr (is_same_v<Wiersz, WierszTrojkataPascala<uint64_t>>) {
+            return make_unique<WierszTrojkataPascala<unsigned __int128>>(*w, n, true);
+        } else if constexpr (is_same_v<Wiersz, WierszTrojkataPascala<unsigned __int128>>) {
+            return make_unique<WierszTrojkataPascala<DuzaLiczba>>(*w, n);
+        } else {
+            return std::move(w);
+        }
+    }, wiersz);
+}
+
+string WierszPromowany::napisElementu(int m) {
+    return visit([m](auto& w) { return w->napisElementu(m); }, wiersz);
+}
+
+string WierszPromowany::napisSumy(int a, int b) {
+    return dlaSumy(a, b, [](const auto& suma) { return naNapis(suma); });
+}
+
+const char* WierszPromowany::nazwaTypu() const {
+    static const char* const nazwy[] = {"int", "u64", "u128", "big"};
+    return nazwy[wiersz.index()];
+}
@@ -0,0 +1,51 @@
+#ifndef WIERSZPROMOWANY_H
+#define WIERSZPROMOWANY_H
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <variant>
+#include "WierszTrojkataPascala.h"
+#include "DuzaLiczba.h"
+
+// Wiersz zaczynany w najtańszym typie. Wiersze liczone są z kontrolą przepełnienia
+// (doPrzepelnienia), a przy pierwszym przepełnieniu ostatni dokładny wiersz przepisywany jest
+// do szerszego typu: int -> uint64_t -> unsigned __int128 -> DuzaLiczba, i liczony dalej od niego,
+// bez wracania do wiersza 0. Suma zakresu, która nie mieści się w typie, też promuje wiersz.
+class WierszPromowany {
+public:
+    explicit WierszPromowany(int n, Przechowywanie przechowywanie = Przechowywanie::caly);
+    std::string napisElementu(int m);
+    std::string napisSumy(int a, int b);
+    const char* nazwaTypu() const;
+    int size;
+
+    // dzialanie(wiersz) dla wiersza w jego aktualnym typie.
+    template <typename Dzialanie>
+    auto dlaWiersza(Dzialanie dzialanie) {
+        return std::visit([&](auto& w) { return dzialanie(*w); }, wiersz);
+    }
+
+    // dzialanie(suma) dla sumy elementów a..b; gdy suma nie mieści się w typie, wiersz jest promowany.
+    template <typename Dzialanie>
+    auto dlaSumy(int a, int b, Dzialanie dzialanie) {
+        for (;;) {
+            try {
+                return std::visit([&](auto& w) { return dzialanie(w->sumaZakresu(a, b)); }, wiersz);
+            } catch (const std::overflow_error& e) {
+                promuj(size - 1);
+            }
+        }
+    }
+
+private:
+    using Wiersze = std::variant<std::unique_ptr<WierszTrojkataPascala<int>>,
+                                 std::unique_ptr<WierszTrojkataPascala<uint64_t>>,
+                                 std::unique_ptr<WierszTrojkataPascala<unsigned __int128>>,
+                                 std::unique_ptr<WierszTrojkataPascala<DuzaLiczba>>>;
+
+    void promuj(int n);
+    Wiersze wiersz;
+};
+
+#endif
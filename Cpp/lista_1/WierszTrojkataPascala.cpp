@@ -1,46 +1,412 @@
 #include "WierszTrojkataPascala.h"
+#include "LiczbaModulo.h"
+#include "SymbolNewtonaModulo.h"
+#include "JadroWiersza.h"
+#include "DokladnySymbolNewtona.h"
+#include "WierszModulo2.h"
+#include "PrzyblizonySymbolNewtona.h"
+#include "WierszNTT.h"
+#include "TablicaWierszy.h"
+#include "PulaWierszy.h"
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 using namespace std;
 
-WierszTrojkataPascala::WierszTrojkataPascala(int n) {
-    if (n < 0) {
+template <typename T>
+WierszTrojkataPascala<T>::WierszTrojkataPascala(int n, Przechowywanie przechowywanie, bool doPrzepelnienia)
+    : przechowywanie(przechowywanie) {
+    if (przygotuj(n, 0, doPrzepelnienia)) {
+        return;
+    }
+    obliczenieNtegoWiersza(n, doPrzepelnienia);
+}
+
+// Wiersz n liczony od gotowego, wcześniejszego wiersza zamiast od wiersza 0,
+// w tym samym trybie przechowywania co poprzedni.
+template <typename T>
+WierszTrojkataPascala<T>::WierszTrojkataPascala(const WierszTrojkataPascala& poprzedni, int n, bool doPrzepelnienia)
+    : przechowywanie(poprzedni.przechowywanie) {
+    if (przygotuj(n, poprzedni.size - 1, doPrzepelnienia) || zNTT(poprzedni.size - 1, n)) {
+        return;
+    }
+    copy(poprzedni.tablica, poprzedni.tablica + poprzedni.przechowywane, bufor);
+    przesunWiersz(poprzedni.size - 1, n, doPrzepelnienia);
+}
+
+template <typename T>
+template <typename Z>
+WierszTrojkataPascala<T>::WierszTrojkataPascala(const WierszTrojkataPascala<Z>& wezszy, int n, bool doPrzepelnienia)
+    : przechowywanie(wezszy.przechowywanie) {
+    if (przygotuj(n, wezszy.size - 1, doPrzepelnienia)) {
+        return;
+    }
+    for (int i = 0; i < wezszy.przechowywane; ++i) {
+        bufor[i] = (T) wezszy.tablica[i];
+    }
+    przesunWiersz(wezszy.size - 1, n, doPrzepelnienia);
+}
+
+// Wspólny początek konstruktorów: sprawdza, że n nie jest przed wierszem odWiersza, ustala
+// rozmiary i bierze wiersz z tablicy albo przydziela bufor; true, gdy wiersz jest już gotowy.
+// Z doPrzepelnienia i tak zatrzymamy się na wierszu po ostatnim dokładnym, więc n przycinamy
+// do niego i nie rezerwujemy miejsca na dalsze.
+template <typename T>
+bool WierszTrojkataPascala<T>::przygotuj(int& n, int odWiersza, bool doPrzepelnienia) {
+    if (n < odWiersza) {
         throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
     }
+    if (doPrzepelnienia && najwiekszyDokladnyWiersz() >= 0) {
+        n = min(n, najwiekszyDokladnyWiersz() + 1);
+    }
     size = n + 1;
-    tablica = new int[size];
-    obliczenieNtegoWiersza(n);
+    przechowywane = przechowywanie == Przechowywanie::polowa ? n / 2 + 1 : size;
+    if (wezZTablicy(n)) {
+        return true;
+    }
+    bufor = PulaWierszy::przydziel<T>(przechowywane);
+    tablica = bufor;
+    return false;
+}
+
+template <typename T>
+WierszTrojkataPascala<T>::WierszTrojkataPascala(WierszTrojkataPascala&& inny) noexcept
+    : tablica(exchange(inny.tablica, nullptr)), size(exchange(inny.size, 0)),
+      przechowywane(exchange(inny.przechowywane, 0)), przechowywanie(inny.przechowywanie),
+      sumy(exchange(inny.sumy, nullptr)), przepelnienia(exchange(inny.przepelnienia, nullptr)),
+      bufor(exchange(inny.bufor, nullptr)) {}
+
+template <typename T>
+WierszTrojkataPascala<T>& WierszTrojkataPascala<T>::operator=(WierszTrojkataPascala&& inny) noexcept {
+    if (this != &inny) {
+        zwolnij();
+        tablica = exchange(inny.tablica, nullptr);
+        size = exchange(inny.size, 0);
+        przechowywane = exchange(inny.przechowywane, 0);
+        przechowywanie = inny.przechowywanie;
+        sumy = exchange(inny.sumy, nullptr);
+        przepelnienia = exchange(inny.przepelnienia, nullptr);
+        bufor = exchange(inny.bufor, nullptr);
+    }
+    return *this;
+}
+
+template <typename T>
+WierszTrojkataPascala<T>::~WierszTrojkataPascala() {
+    zwolnij();
+}
+
+template <typename T>
+void WierszTrojkataPascala<T>::zwolnij() {
+    PulaWierszy::zwolnij(bufor);
+    PulaWierszy::zwolnij(sumy);
+    PulaWierszy::zwolnij(przepelnienia);
+}
+
+template <typename T>
+span<const T> WierszTrojkataPascala<T>::widok() const {
+    return span<const T>(tablica, przechowywane);
 }
 
-WierszTrojkataPascala::~WierszTrojkataPascala() {
-    delete[] tablica;
+// Małe wiersze int i uint64_t są gotowe od kompilacji: wiersz tylko wskazuje na dane tylko do odczytu,
+// bez bufora i bez alokacji. Wiersze z tablicy nigdy nie są przesuwane w miejscu - następny wiersz
+// liczony od takiego kopiuje go do własnego bufora.
+template <typename T>
+bool WierszTrojkataPascala<T>::wezZTablicy(int n) {
+    const T* gotowy = nullptr;
+    if constexpr (is_same_v<T, int>) {
+        if (n <= TablicaInt::NAJWIEKSZY) {
+            gotowy = TablicaInt::wiersz(n);
+        }
+    } else if constexpr (is_same_v<T, uint64_t>) {
+        if (n <= TablicaU64::NAJWIEKSZY) {
+            gotowy = TablicaU64::wiersz(n);
+        }
+    }
+    tablica = gotowy;
+    return gotowy != nullptr;
 }
 
-int WierszTrojkataPascala::MtyElementWiersza(int m) {
+template <typename T>
+T WierszTrojkataPascala<T>::MtyElementWiersza(int m) {
     if (m < 0 || m >= size) {
         throw out_of_range(to_string(m) + " - liczba spoza zakresu");
     }
-    return tablica[m];
+    return m < przechowywane ? tablica[m] : tablica[size - 1 - m];
 }
 
-void WierszTrojkataPascala::obliczenieNtegoWiersza(int n) {
-    if (n == 0) {
-        tablica[0] = 1;
-        return;
+template <typename T>
+string WierszTrojkataPascala<T>::napisElementu(int m) {
+    return naNapis(MtyElementWiersza(m));
+}
+
+// Suma + skladnik w arytmetyce typu; zwraca true, gdy suma się zawinęła.
+// int sumujemy jako uint32_t, zakres int sprawdza dopiero sumaZakresu.
+template <typename T>
+static bool dodajZPrzeniesieniem(T& suma, T skladnik) {
+    if constexpr (is_same_v<T, LiczbaModulo>) {
+        suma += skladnik;
+        return false;
+    } else if constexpr (is_same_v<T, int>) {
+        uint32_t wynik = (uint32_t) suma + (uint32_t) skladnik;
+        bool przeniesienie = wynik < (uint32_t) skladnik;
+        suma = (int) wynik;
+        return przeniesienie;
+    } else {
+        suma += skladnik;
+        return suma < skladnik;
+    }
+}
+
+template <typename T>
+void WierszTrojkataPascala<T>::zbudujSumy() {
+    sumy = PulaWierszy::przydziel<T>(size + 1);
+    sumy[0] = T(0);
+    if constexpr (!is_same_v<T, LiczbaModulo>) {
+        przepelnienia = PulaWierszy::przydziel<uint32_t>(size + 1);
+        przepelnienia[0] = 0;
+    }
+    for (int k = 0; k < size; ++k) {
+        sumy[k + 1] = sumy[k];
+        bool przeniesienie = dodajZPrzeniesieniem(sumy[k + 1], MtyElementWiersza(k));
+        if constexpr (!is_same_v<T, LiczbaModulo>) {
+            przepelnienia[k + 1] = przepelnienia[k] + przeniesienie;
+        }
+    }
+}
+
+// Suma elementów a..b jako różnica dwóch sum prefiksowych, więc O(1) po pierwszym wywołaniu.
+template <typename T>
+T WierszTrojkataPascala<T>::sumaZakresu(int a, int b) {
+    if (a < 0 || a >= size) {
+        throw out_of_range(to_string(a) + " - liczba spoza zakresu");
+    }
+    if (b < 0 || b >= size) {
+        throw out_of_range(to_string(b) + " - liczba spoza zakresu");
+    }
+    if (a > b) {
+        throw invalid_argument(to_string(a) + ".." + to_string(b) + " - nieprawidłowy zakres");
+    }
+    if (!sumy) {
+        zbudujSumy();
     }
 
-    if (n == 1) {
-        tablica[0] = 1;
-        tablica[1] = 1;
+    if constexpr (is_same_v<T, LiczbaModulo>) {
+        LiczbaModulo wynik = sumy[b + 1];
+        wynik -= sumy[a];
+        return wynik;
+    } else {
+        // Różnica zawiniętych sum jest dokładna, o ile między a i b nie było pełnego zawinięcia.
+        using U = conditional_t<is_same_v<T, int>, uint32_t, T>;
+        U gorna = (U) sumy[b + 1];
+        U dolna = (U) sumy[a];
+        U wynik = gorna - dolna;
+        uint32_t zawiniecia = przepelnienia[b + 1] - przepelnienia[a] - (gorna < dolna);
+        if (zawiniecia != 0 || (is_same_v<T, int> && wynik > (U) INT32_MAX)) {
+            throw overflow_error(to_string(a) + ".." + to_string(b) + " - wynik przekracza zakres typu");
+        }
+        return (T) wynik;
+    }
+}
+
+template <typename T>
+string WierszTrojkataPascala<T>::napisSumy(int a, int b) {
+    return naNapis(sumaZakresu(a, b));
+}
+
+template <typename T>
+void WierszTrojkataPascala<T>::obliczenieNtegoWiersza(int n, bool doPrzepelnienia) {
+    if (zNTT(0, n)) {
         return;
     }
+    bufor[0] = T(1);
+    przesunWiersz(0, n, doPrzepelnienia);
+}
 
-    WierszTrojkataPascala poprzedni_wiersz(n - 1);
+// Wiersz modulo p wprost przez NTT, gdy to taniej niż przesuwanie od wiersza z.
+template <typename T>
+bool WierszTrojkataPascala<T>::zNTT(int z, int n) {
+    if constexpr (is_same_v<T, LiczbaModulo>) {
+        if (WierszNTT::szybszyOdDodawania(LiczbaModulo::modul, z, n)) {
+            vector<uint32_t> wiersz = WierszNTT::wiersz(n, LiczbaModulo::modul);
+            for (int i = 0; i < przechowywane; ++i) {
+                bufor[i].wartosc = wiersz[i];
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+// Wiersz n liczony w miejscu: wiersz r powstaje z wiersza r-1 w tym samym buforze,
+// idąc od prawej, żeby bufor[i - 1] była jeszcze wartością z poprzedniego wiersza.
+template <typename T>
+void WierszTrojkataPascala<T>::przesunWiersz(int z, int n, bool doPrzepelnienia) {
+    for (int r = z + 1; r <= n; ++r) {
+        if (doPrzepelnienia && srodekPrzepelniony(r)) {
+            size = r;
+            przechowywane = przechowywanie == Przechowywanie::polowa ? (r - 1) / 2 + 1 : size;
+            return;
+        }
+        if (przechowywanie == Przechowywanie::caly) {
+            bufor[r] = T(1);
+            dodajSasiednie(r);
+            continue;
+        }
 
-    for (int i = 0; i <= n; ++i) {
-        if (i == 0 || i == n) {
-            tablica[i] = 1;
+        // Dla parzystego r przybywa środkowy element C(r, r/2) = 2 * C(r-1, r/2-1),
+        // bo jego prawy rodzic jest lustrzanym odbiciem lewego.
+        int h = r / 2 + 1;
+        if (r % 2 == 0) {
+            if constexpr (is_same_v<T, int>) {
+                bufor[h - 1] = (int) (2u * (uint32_t) bufor[h - 2]);
+            } else {
+                bufor[h - 1] = bufor[h - 2];
+                bufor[h - 1] += bufor[h - 2];
+            }
+            dodajSasiednie(h - 1);
         } else {
-            tablica[i] = poprzedni_wiersz.tablica[i - 1] + poprzedni_wiersz.tablica[i];
+            dodajSasiednie(h);
         }
     }
-}
\ No newline at end of file
+}
+
+// Największy element wiersza r to C(r, r/2) = C(r-1, r/2-1) + C(r-1, r/2), a pozostałe sumy
+// jądra są od niego mniejsze, więc jedno sprawdzone dodawanie na wiersz wystarcza,
+// a samo jądro zostaje wektorowe i bez sprawdzeń.
+template <typename T>
+bool WierszTrojkataPascala<T>::srodekPrzepelniony(int r) {
+    if constexpr (is_same_v<T, LiczbaModulo>) {
+        return false;
+    } else {
+        if (r < 2) {
+            return false;
+        }
+        int k = r / 2;
+        T srodek;
+        return __builtin_add_overflow(bufor[min(k - 1, r - k)], bufor[min(k, r - 1 - k)], &srodek);
+    }
+}
+
+// bufor[i] += bufor[i - 1] dla i = k-1..1.
+template <typename T>
+void WierszTrojkataPascala<T>::dodajSasiednie(int k) {
+    JadroWiersza::dodajSasiednie(bufor, k);
+}
+
+template <typename T>
+size_t WierszTrojkataPascala<T>::zajetaPamiec() const {
+    size_t bajty = bufor ? sizeof(T) * przechowywane : 0;
+    if (sumy) {
+        bajty += sizeof(T) * (size + 1);
+    }
+    if (przepelnienia) {
+        bajty += sizeof(uint32_t) * (size + 1);
+    }
+    return bajty;
+}
+
+// Największe n, dla którego cały wiersz n mieści się w T bez przepełnienia.
+template <typename T>
+int WierszTrojkataPascala<T>::najwiekszyDokladnyWiersz() {
+    if constexpr (is_same_v<T, int>) {
+        return 33;
+    } else if constexpr (is_same_v<T, uint64_t>) {
+        return 67;
+    } else if constexpr (is_same_v<T, unsigned __int128>) {
+        return 131;
+    } else {
+        return -1;
+    }
+}
+
+// C(n, m) ze wzoru C(n, i + 1) = C(n, i) * (n - i) / (i + 1), bez budowania wiersza.
+// Przed mnożeniem skracamy przez nwd, więc wynik pośredni nigdy nie przekracza C(n, i + 1).
+template <typename T>
+unsigned __int128 WierszTrojkataPascala<T>::symbolNewtona(long long n, long long m) {
+    if (n < 0) {
+        throw invalid_argument(to_string(n) + " - nieprawidłowy numer wiersza");
+    }
+    if (m < 0 || m > n) {
+        throw out_of_range(to_string(m) + " - liczba spoza zakresu");
+    }
+
+    long long k = min(m, n - m);
+    unsigned __int128 wynik = 1;
+    for (long long i = 0; i < k; ++i) {
+        unsigned long long licznik = n - i;
+        unsigned long long mianownik = i + 1;
+        unsigned long long dzielnik = gcd((unsigned long long) (wynik % mianownik), mianownik);
+        wynik /= dzielnik;
+        mianownik /= dzielnik;
+        licznik /= mianownik;
+        if (__builtin_mul_overflow(wynik, (unsigned __int128) licznik, &wynik)) {
+            throw overflow_error(to_string(m) + " - wynik przekracza zakres 128 bitów");
+        }
+    }
+    return wynik;
+}
+
+template <typename T>
+uint32_t WierszTrojkataPascala<T>::symbolNewtonaModulo(unsigned long long n, unsigned long long m, unsigned long long p) {
+    if (m > n) {
+        throw out_of_range(to_string(m) + " - liczba spoza zakresu");
+    }
+    // Sprawdzane przed zawężeniem do uint32_t, inaczej 2^32 + 3 liczyłoby się jako 3.
+    if (p >= (1u << 31)) {
+        throw invalid_argument(to_string(p) + " - moduł musi być liczbą pierwszą mniejszą od 2^31");
+    }
+    if (p == 2) {
+        return WierszTrojkataPascala<bool>::nieparzysty(n, m);
+    }
+    return SymbolNewtonaModulo::dlaModulu(p).oblicz(n, m);
+}
+
+template <typename T>
+DuzaLiczba WierszTrojkataPascala<T>::symbolNewtonaDokladnie(long long n, long long m, int liczbaWatkow) {
+    return DokladnySymbolNewtona::oblicz(n, m, liczbaWatkow);
+}
+
+// Przybliżony ln C(n, m) dla dowolnie dużego n, gdy dokładna wartość nie jest potrzebna.
+template <typename T>
+double WierszTrojkataPascala<T>::logSymbolNewtona(long long n, long long m) {
+    return PrzyblizonySymbolNewtona::logarytm(n, m);
+}
+
+string naNapis(int liczba) {
+    return to_string(liczba);
+}
+
+string naNapis(uint64_t liczba) {
+    return to_string(liczba);
+}
+
+string naNapis(unsigned __int128 liczba) {
+    string napis;
+    do {
+        napis.insert(napis.begin(), char('0' + int(liczba % 10)));
+        liczba /= 10;
+    } while (liczba != 0);
+    return napis;
+}
+
+void LiczbaModulo::ustawModul(unsigned long long p) {
+    if (p == 0 || p >= (1u << 31)) {
+        throw invalid_argument(to_string(p) + " - nieprawidłowy moduł");
+    }
+    modul = p;
+}
+
+string naNapis(LiczbaModulo liczba) {
+    return to_string(liczba.wartosc);
+}
+
+template class WierszTrojkataPascala<int>;
+template class WierszTrojkataPascala<uint64_t>;
+template class WierszTrojkataPascala<unsigned __int128>;
+template class WierszTrojkataPascala<LiczbaModulo>;
+
+template WierszTrojkataPascala<uint64_t>::WierszTrojkataPascala(const WierszTrojkataPascala<int>&, int, bool);
+template WierszTrojkataPascala<unsigned __int128>::WierszTrojkataPascala(const WierszTrojkataPascala<uint64_t>&, int, bool);
@@ -1,18 +1,76 @@
 #ifndef WIERSZTROJKATAPASCALA_H
 #define WIERSZTROJKATAPASCALA_H
 
+#include <cstdint>
 #include <iostream>
+#include <span>
+#include <string>
 
+class DuzaLiczba;
+
+// Wiersz jest symetryczny, więc w trybie polowa trzymamy tylko elementy 0..n/2,
+// a MtyElementWiersza odbija indeksy z prawej połowy.
+enum class Przechowywanie { caly, polowa };
+
+// Typ elementu T musi dać się zbudować z 1 i dodać przez +=.
+// Instancje: int, uint64_t, unsigned __int128, LiczbaModulo oraz
+// specjalizacje dla DuzaLiczba (DuzaLiczba.h) i bool, czyli modulo 2 (WierszModulo2.h).
+template <typename T = int>
 class WierszTrojkataPascala {
 public:
-    explicit WierszTrojkataPascala(int n);
+    // Z doPrzepelnienia = true wiersz nie zawija się, tylko zatrzymuje na ostatnim wierszu,
+    // którego elementy mieszczą się w T; wtedy size - 1 < n.
+    explicit WierszTrojkataPascala(int n, Przechowywanie przechowywanie = Przechowywanie::caly,
+                                   bool doPrzepelnienia = false);
+    WierszTrojkataPascala(const WierszTrojkataPascala& poprzedni, int n, bool doPrzepelnienia = false);
+    // Promocja: wiersz węższego typu Z przepisany do T i przesunięty dalej do n.
+    template <typename Z>
+    WierszTrojkataPascala(const WierszTrojkataPascala<Z>& wezszy, int n, bool doPrzepelnienia);
+    // Wiersze tylko się przenosi: przeniesienie przejmuje bufory w O(1), a przeniesiony wiersz jest pusty (size == 0).
+    WierszTrojkataPascala(const WierszTrojkataPascala&) = delete;
+    WierszTrojkataPascala& operator=(const WierszTrojkataPascala&) = delete;
+    WierszTrojkataPascala(WierszTrojkataPascala&& inny) noexcept;
+    WierszTrojkataPascala& operator=(WierszTrojkataPascala&& inny) noexcept;
     ~WierszTrojkataPascala();
-    int MtyElementWiersza(int m);
-    int* tablica;
+    // Przechowywane elementy (w trybie polowa tylko 0..n/2) bez kopiowania, ważne, dopóki żyje wiersz.
+    std::span<const T> widok() const;
+    T MtyElementWiersza(int m);
+    std::string napisElementu(int m);
+    T sumaZakresu(int a, int b);
+    std::string napisSumy(int a, int b);
+    size_t zajetaPamiec() const;
+    static unsigned __int128 symbolNewtona(long long n, long long m);
+    static uint32_t symbolNewtonaModulo(unsigned long long n, unsigned long long m, unsigned long long p);
+    static DuzaLiczba symbolNewtonaDokladnie(long long n, long long m, int liczbaWatkow);
+    static double logSymbolNewtona(long long n, long long m);
+    static int najwiekszyDokladnyWiersz();
+    // Przechowywane elementy: wiersz z TablicaWierszy albo bufor, gdy wiersz był liczony.
+    const T* tablica = nullptr;
     int size;
+    int przechowywane;
+    Przechowywanie przechowywanie;
+    // Sumy prefiksowe budowane przy pierwszym sumaZakresu: sumy[k] to suma elementów 0..k-1.
+    // Typy stałej szerokości się zawijają, więc przepelnienia[k] liczy zawinięcia do k.
+    T* sumy = nullptr;
+    uint32_t* przepelnienia = nullptr;
 
 private:
-    void obliczenieNtegoWiersza(int n);
+    // Własny bufor wiersza liczonego; dla wiersza z tablicy nullptr.
+    T* bufor = nullptr;
+
+    bool przygotuj(int& n, int odWiersza, bool doPrzepelnienia);
+    bool wezZTablicy(int n);
+    void obliczenieNtegoWiersza(int n, bool doPrzepelnienia);
+    bool zNTT(int z, int n);
+    void zbudujSumy();
+    void zwolnij();
+    void przesunWiersz(int z, int n, bool doPrzepelnienia = false);
+    bool srodekPrzepelniony(int r);
+    void dodajSasiednie(int k);
 };
 
-#endif
\ No newline at end of file
+std::string naNapis(int liczba);
+std::string naNapis(uint64_t liczba);
+std::string naNapis(unsigned __int128 liczba);
+
+#endif
@@ -0,0 +1,139 @@
+#include "WyjscieBuforowane.h"
+#include "DuzaLiczba.h"
+#include "LiczbaModulo.h"
+#include "WierszModulo2.h"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <unistd.h>
+
+using namespace std;
+
+WyjscieBuforowane::WyjscieBuforowane(FILE* plik, size_t pojemnosc)
+    : deskryptor(fileno(plik)), bufor(pojemnosc) {
+    fflush(plik);
+}
+
+WyjscieBuforowane::~WyjscieBuforowane() {
+    try {
+        oproznij();
+    } catch (const exception& e) {
+    }
+}
+
+void WyjscieBuforowane::oproznij() {
+    size_t wyslane = 0;
+    while (wyslane < zajete) {
+        ssize_t wynik = write(deskryptor, bufor.data() + wyslane, zajete - wyslane);
+        if (wynik < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            zajete = 0;
+            throw runtime_error(string("zapis wyjścia: ") + strerror(errno));
+        }
+        wyslane += wynik;
+    }
+    zajete = 0;
+}
+
+// Wolne miejsce na co najmniej bajty znaków; element dłuższy niż cały bufor go powiększa.
+char* WyjscieBuforowane::miejsce(size_t bajty) {
+    if (zajete + bajty > bufor.size()) {
+        oproznij();
+        if (bajty > bufor.size()) {
+            bufor.resize(bajty);
+        }
+    }
+    return bufor.data() + zajete;
+}
+
+void WyjscieBuforowane::dopisz(char znak) {
+    *miejsce(1) = znak;
+    ++zajete;
+}
+
+void WyjscieBuforowane::dopisz(const char* tekst, size_t dlugosc) {
+    memcpy(miejsce(dlugosc), tekst, dlugosc);
+    zajete += dlugosc;
+}
+
+void WyjscieBuforowane::dopisz(const string& tekst) {
+    dopisz(tekst.data(), tekst.size());
+}
+
+void WyjscieBuforowane::dopiszLiczbe(int liczba) {
+    char* poczatek = miejsce(11);
+    zajete += to_chars(poczatek, poczatek + 11, liczba).ptr - poczatek;
+}
+
+void WyjscieBuforowane::dopiszLiczbe(long long liczba) {
+    char* poczatek = miejsce(20);
+    zajete += to_chars(poczatek, poczatek + 20, liczba).ptr - poczatek;
+}
+
+void WyjscieBuforowane::dopiszLiczbe(uint64_t liczba) {
+    char* poczatek = miejsce(20);
+    zajete += to_chars(poczatek, poczatek + 20, liczba).ptr - poczatek;
+}
+
+// Starsza część przez rekurencję, młodsze 19 cyfr z zerami wiodącymi.
+void WyjscieBuforowane::dopiszLiczbe(unsigned __int128 liczba) {
+    if (liczba <= UINT64_MAX) {
+        dopiszLiczbe((uint64_t) liczba);
+        return;
+    }
+    dopiszLiczbe(liczba / DuzaLiczba::DZIESIEC_DO_19);
+    uint64_t mlodsze = (uint64_t) (liczba % DuzaLiczba::DZIESIEC_DO_19);
+    char* poczatek = miejsce(19);
+    for (int c = 18; c >= 0; --c) {
+        poczatek[c] = char('0' + mlodsze % 10);
+        mlodsze /= 10;
+    }
+    zajete += 19;
+}
+
+void WyjscieBuforowane::dopiszLiczbe(LiczbaModulo liczba) {
+    dopiszLiczbe((uint64_t) liczba.wartosc);
+}
+
+void WyjscieBuforowane::dopiszLiczbe(bool liczba) {
+    dopisz(liczba ? '1' : '0');
+}
+
+void WyjscieBuforowane::dopiszLiczbe(const DuzaLiczba& liczba) {
+    dopiszLimby(liczba.limby.data(), (int) liczba.limby.size());
+}
+
+void WyjscieBuforowane::dopiszLimby(const uint64_t* limby, int dlugosc) {
+    zajete += DuzaLiczba::zapiszCyfry(limby, dlugosc, miejsce(DuzaLiczba::maksCyfr(dlugosc)));
+}
+
+template <typename T>
+void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<T>& wiersz) {
+    int n = wiersz.size - 1;
+    for (int i = 0; i <= n; ++i) {
+        if constexpr (is_same_v<T, DuzaLiczba>) {
+            int j = i < wiersz.przechowywane ? i : n - i;
+            dopiszLimby(wiersz.arena + (size_t) j * wiersz.szerokosc, wiersz.dlugosci[j]);
+        } else if constexpr (is_same_v<T, bool>) {
+            dopiszLiczbe(wiersz.MtyElementWiersza(i));
+        } else {
+            dopiszLiczbe(wiersz.tablica[i < wiersz.przechowywane ? i : n - i]);
+        }
+        dopisz(' ');
+    }
+}
+
+void WyjscieBuforowane::dopiszWiersz(WierszPromowany& wiersz) {
+    wiersz.dlaWiersza([&](auto& w) { dopiszWiersz(w); });
+}
+
+template void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<int>&);
+template void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<uint64_t>&);
+template void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<unsigned __int128>&);
+template void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<LiczbaModulo>&);
+template void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<DuzaLiczba>&);
+template void WyjscieBuforowane::dopiszWiersz(WierszTrojkataPascala<bool>&);
@@ -0,0 +1,44 @@
+#ifndef WYJSCIEBUFOROWANE_H
+#define WYJSCIEBUFOROWANE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "WierszTrojkataPascala.h"
+#include "WierszPromowany.h"
+
+class LiczbaModulo;
+
+// Tekst wyjścia składany w jednym buforze (liczby przez std::to_chars, bez pośrednich stringów)
+// i wysyłany do deskryptora pliku kilkoma dużymi write(2). Przed pierwszym zapisem opróżnia
+// bufor stdio pliku, a w destruktorze swój, więc można go przeplatać z printf na tym samym pliku.
+class WyjscieBuforowane {
+public:
+    explicit WyjscieBuforowane(FILE* plik, size_t pojemnosc = 1 << 20);
+    ~WyjscieBuforowane();
+    void dopisz(char znak);
+    void dopisz(const char* tekst, size_t dlugosc);
+    void dopisz(const std::string& tekst);
+    void dopiszLiczbe(int liczba);
+    void dopiszLiczbe(long long liczba);
+    void dopiszLiczbe(uint64_t liczba);
+    void dopiszLiczbe(unsigned __int128 liczba);
+    void dopiszLiczbe(LiczbaModulo liczba);
+    void dopiszLiczbe(bool liczba);
+    void dopiszLiczbe(const DuzaLiczba& liczba);
+    void dopiszLimby(const uint64_t* limby, int dlugosc);
+    // Elementy 0..n rozdzielone spacjami (ze spacją po ostatnim, jak w wyjściu tekstowym).
+    template <typename T>
+    void dopiszWiersz(WierszTrojkataPascala<T>& wiersz);
+    void dopiszWiersz(WierszPromowany& wiersz);
+    void oproznij();
+
+private:
+    char* miejsce(size_t bajty);
+    int deskryptor;
+    std::vector<char> bufor;
+    size_t zajete = 0;
+};
+
+#endif
@@ -0,0 +1,399 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <thread>
+#include "WierszTrojkataPascala.h"
+#include "JadroWiersza.h"
+#include "LiczbaModulo.h"
+#include "RownoleglyTrojkat.h"
+#include "WierszModulo2.h"
+#include "DuzaLiczba.h"
+#include "PrzyblizonySymbolNewtona.h"
+#include "WyjscieBuforowane.h"
+#include "PulaWierszy.h"
+#include "TablicaWierszy.h"
+
+using namespace std;
+
+static long long licznikAlokacji = 0;
+
+void* operator new(size_t rozmiar) {
+    ++licznikAlokacji;
+    if (void* p = malloc(rozmiar)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void* operator new[](size_t rozmiar) {
+    return operator new(rozmiar);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+// Poprzednia, rekurencyjna wersja wiersza - tylko jako punkt odniesienia.
+class WierszRekurencyjny {
+public:
+    explicit WierszRekurencyjny(int n) {
+        size = n + 1;
+        tablica = new int[size];
+        if (n == 0) {
+            tablica[0] = 1;
+            return;
+        }
+        WierszRekurencyjny poprzedni_wiersz(n - 1);
+        for (int i = 0; i <= n; ++i) {
+            if (i == 0 || i == n) {
+                tablica[i] = 1;
+            } else {
+                tablica[i] = poprzedni_wiersz.tablica[i - 1] + poprzedni_wiersz.tablica[i];
+            }
+        }
+    }
+
+    ~WierszRekurencyjny() {
+        delete[] tablica;
+    }
+
+    int* tablica;
+    int size;
+};
+
+template <typename Wiersz>
+static void zmierz(const char* nazwa, int n) {
+    long long alokacjePrzed = licznikAlokacji;
+    auto start = chrono::steady_clock::now();
+    Wiersz wiersz(n);
+    auto koniec = chrono::steady_clock::now();
+    volatile int wynik = wiersz.tablica[n / 2];
+    (void) wynik;
+
+    double ms = chrono::duration<double, milli>(koniec - start).count();
+    printf("%-14s n = %-7d alokacje: %-7lld czas: %.3f ms\n", nazwa, n, licznikAlokacji - alokacjePrzed, ms);
+}
+
+// Wiersze z TablicaWierszy tylko wskazują na dane tylko do odczytu, więc nie mogą nic alokować.
+template <typename T>
+static bool sprawdzTablice(const char* nazwa, int nMaks) {
+    long long alokacjePrzed = licznikAlokacji;
+    for (int n = 0; n <= nMaks; ++n) {
+        WierszTrojkataPascala<T> caly(n);
+        WierszTrojkataPascala<T> polowa(n, Przechowywanie::polowa);
+    }
+    long long alokacje = licznikAlokacji - alokacjePrzed;
+    printf("%-14s n <= %-6d alokacje: %lld%s\n", nazwa, nMaks, alokacje, alokacje ? "  (oczekiwano 0)" : "");
+    return alokacje == 0;
+}
+
+static bool sprawdzTablice() {
+    bool intBezAlokacji = sprawdzTablice<int>("tablica int", TablicaInt::NAJWIEKSZY);
+    bool u64BezAlokacji = sprawdzTablice<uint64_t>("tablica u64", TablicaU64::NAJWIEKSZY);
+    return intBezAlokacji && u64BezAlokacji;
+}
+
+// Elementy na sekundę dla kroku wiersza na danym poziomie ISA; suma kontrolna musi
+// być taka sama na każdym poziomie.
+template <typename T>
+static void zmierzJadro(const char* nazwaTypu, PoziomISA poziom, int n) {
+    JadroWiersza::ustawPoziom(poziom);
+    auto start = chrono::steady_clock::now();
+    WierszTrojkataPascala<T> wiersz(n);
+    auto koniec = chrono::steady_clock::now();
+
+    unsigned long long suma = 0;
+    for (int i = 0; i <= n; ++i) {
+        for (char c : wiersz.napisElementu(i)) {
+            suma = suma * 31 + c;
+        }
+    }
+
+    double s = chrono::duration<double>(koniec - start).count();
+    double elementy = (double) n * (n + 1) / 2;
+    printf("%-6s %-7s n = %-6d %8.3f Melem/s  suma kontrolna: %016llx\n",
+           nazwaTypu, JadroWiersza::nazwa(poziom), n, elementy / s / 1e6, suma);
+}
+
+// Wiersz modulo 2 na bitach wobec LiczbaModulo z p = 2; sumy kontrolne muszą się zgadzać.
+template <typename T>
+static void zmierzModulo2(const char* nazwa, int n) {
+    auto start = chrono::steady_clock::now();
+    WierszTrojkataPascala<T> wiersz(n);
+    auto koniec = chrono::steady_clock::now();
+
+    unsigned long long suma = 0;
+    for (int i = 0; i <= n; ++i) {
+        suma = suma * 31 + (wiersz.napisElementu(i)[0] == '1');
+    }
+
+    double ms = chrono::duration<double, milli>(koniec - start).count();
+    printf("%-14s n = %-9d czas: %10.3f ms  suma kontrolna: %016llx\n", nazwa, n, ms, suma);
+}
+
+// Granice błędu obiecane w PrzyblizonySymbolNewtona.h dla n <= 2000.
+static const double TOLERANCJA_LOGARYTMU = 7e-13;
+static const double TOLERANCJA_WARTOSCI = 4e-13;
+
+// Błąd przybliżenia Stirlinga wobec dokładnych wierszy 0..nMaks (bezwzględny dla ln C,
+// względny dla C tam, gdzie C mieści się w double); false, gdy przekracza tolerancję.
+static bool sprawdzPrzyblizenie(int nMaks) {
+    double bladLogarytmu = 0, bladWartosci = 0;
+    for (int n = 0; n <= nMaks; ++n) {
+        WierszTrojkataPascala<DuzaLiczba> wiersz(n, Przechowywanie::polowa);
+        for (int k = 0; k <= n / 2; ++k) {
+            DuzaLiczba element = wiersz.MtyElementWiersza(k);
+            const vector<uint64_t>& limby = element.limby;
+            int dlugosc = (int) limby.size();
+            double gora = dlugosc > 1 ? ldexp((double) limby[dlugosc - 1], 64) + (double) limby[dlugosc - 2]
+                                      : (double) limby[0];
+            double dokladny = log(gora) + 64.0 * max(dlugosc - 2, 0) * log(2.0);
+            double przyblizony = PrzyblizonySymbolNewtona::logarytm(n, k);
+            bladLogarytmu = max(bladLogarytmu, fabs(przyblizony - dokladny));
+            if (dokladny < 700) {
+                bladWartosci = max(bladWartosci, fabs(exp(przyblizony) / exp(dokladny) - 1));
+            }
+        }
+    }
+    printf("Stirling       n <= %-6d max |błąd ln C|: %.3e  max względny błąd C (C < e^700): %.3e\n",
+           nMaks, bladLogarytmu, bladWartosci);
+    if (bladLogarytmu > TOLERANCJA_LOGARYTMU || bladWartosci > TOLERANCJA_WARTOSCI) {
+        printf("Stirling       błąd ponad tolerancję (ln C: %.0e, C: %.0e)\n", TOLERANCJA_LOGARYTMU, TOLERANCJA_WARTOSCI);
+        return false;
+    }
+    return true;
+}
+
+// Czas zapytania przybliżonego dla bardzo dużego n; ścieżka nie powinna alokować.
+static void zmierzPrzyblizenie() {
+    const long long n = 1000000000000LL;
+    const int zapytania = 1000000;
+    long long alokacjePrzed = licznikAlokacji;
+    volatile double suma = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < zapytania; ++i) {
+        suma = suma + PrzyblizonySymbolNewtona::logarytm(n, n / 2 - i * 7919LL);
+    }
+    auto koniec = chrono::steady_clock::now();
+    double ns = chrono::duration<double, nano>(koniec - start).count() / zapytania;
+    printf("Stirling       n = %lld  %.1f ns/zapytanie  alokacje: %lld\n", n, ns, licznikAlokacji - alokacjePrzed);
+}
+
+// Wiersz modulo p przez NTT (konstruktor z n) wobec dodawania kolejnych wierszy (przesunięcie od wiersza 0).
+static unsigned long long sumaKontrolna(WierszTrojkataPascala<LiczbaModulo>& wiersz) {
+    unsigned long long suma = 0;
+    for (int i = 0; i < wiersz.size; ++i) {
+        suma = suma * 31 + wiersz.MtyElementWiersza(i).wartosc;
+    }
+    return suma;
+}
+
+static void zmierzNTT(uint32_t p, int n, bool zDodawaniem) {
+    LiczbaModulo::ustawModul(p);
+    auto start = chrono::steady_clock::now();
+    WierszTrojkataPascala<LiczbaModulo> wiersz(n);
+    double msNTT = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    printf("NTT            p = %-10u n = %-8d czas: %10.3f ms  suma kontrolna: %016llx\n",
+           p, n, msNTT, sumaKontrolna(wiersz));
+    if (zDodawaniem) {
+        start = chrono::steady_clock::now();
+        WierszTrojkataPascala<LiczbaModulo> zero(0);
+        WierszTrojkataPascala<LiczbaModulo> dodawany(zero, n);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        printf("dodawanie      p = %-10u n = %-8d czas: %10.3f ms  suma kontrolna: %016llx\n",
+               p, n, ms, sumaKontrolna(dodawany));
+    }
+}
+
+// Tekst wiersza do /dev/null: strumień z napisem na element i endl wobec WyjscieBuforowane.
+template <typename T>
+static void zmierzWypisywanie(const char* nazwa, int n) {
+    WierszTrojkataPascala<T> wiersz(n);
+
+    auto start = chrono::steady_clock::now();
+    {
+        ofstream strumien("/dev/null");
+        for (int i = 0; i <= n; ++i) {
+            strumien << wiersz.napisElementu(i) << " ";
+        }
+        strumien << endl;
+    }
+    double msStrumien = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    FILE* plik = fopen("/dev/null", "w");
+    long long alokacjePrzed = licznikAlokacji;
+    start = chrono::steady_clock::now();
+    {
+        WyjscieBuforowane wyjscie(plik);
+        wyjscie.dopiszWiersz(wiersz);
+        wyjscie.dopisz('\n');
+    }
+    double msBufor = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    long long alokacje = licznikAlokacji - alokacjePrzed;
+    fclose(plik);
+
+    printf("%-14s n = %-8d ostream: %10.3f ms  bufor: %10.3f ms  x%-6.2f alokacje: %lld\n",
+           nazwa, n, msStrumien, msBufor, msStrumien / msBufor, alokacje);
+}
+
+// Wiersze tworzone i niszczone jak we wsadzie lub w serwerze: ze sterty i z puli.
+// Drugi przebieg z puli to stan ustalony - bufory wracają z list wolnych, więc alokacji ma nie być.
+static void zmierzPule(int zapytania, int nMaks) {
+    auto przebieg = [&](const char* nazwa) {
+        srand(1);
+        long long alokacjePrzed = licznikAlokacji;
+        unsigned long long suma = 0;
+        auto start = chrono::steady_clock::now();
+        for (int q = 0; q < zapytania; ++q) {
+            WierszTrojkataPascala<LiczbaModulo> wiersz(rand() % nMaks, Przechowywanie::polowa);
+            suma = suma * 31 + wiersz.tablica[wiersz.przechowywane - 1].wartosc;
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        printf("%-14s %d wierszy n < %d  czas: %9.3f ms  alokacje: %-7lld suma kontrolna: %016llx\n",
+               nazwa, zapytania, nMaks, ms, licznikAlokacji - alokacjePrzed, suma);
+    };
+
+    przebieg("sterta");
+    PulaWierszy pula;
+    PulaWierszy::Uzycie uzycie(pula);
+    przebieg("pula");
+    przebieg("pula, ustalony");
+    printf("%-14s przydzialy: %lld ponownie: %lld bloki: %lld\n", "pula",
+           pula.przydzialy, pula.ponownieUzyte, pula.alokacjeBlokow);
+}
+
+// Cały trójkąt 0..N-1 w pamięci, układ jak w TrojkatWPliku. liczbaWatkow = 0 oznacza
+// ścieżkę sekwencyjną (kopia wiersza i jądro w miejscu), pozostałe - front fali.
+static double zmierzTrojkat(int liczbaWierszy, int liczbaWatkow, double odniesienie) {
+    size_t elementy = (size_t) liczbaWierszy * (liczbaWierszy + 1) / 2;
+    LiczbaModulo* dane = new LiczbaModulo[elementy];
+    auto start = chrono::steady_clock::now();
+    if (liczbaWatkow == 0) {
+        for (int r = 0; r < liczbaWierszy; ++r) {
+            LiczbaModulo* biezacy = dane + (size_t) r * (r + 1) / 2;
+            if (r > 0) {
+                memcpy(biezacy, biezacy - r, r * sizeof(LiczbaModulo));
+            }
+            biezacy[r] = LiczbaModulo(1);
+            JadroWiersza::dodajSasiednie(biezacy, r);
+        }
+    } else {
+        RownoleglyTrojkat<LiczbaModulo>::zbuduj(dane, liczbaWierszy, liczbaWatkow);
+    }
+    auto koniec = chrono::steady_clock::now();
+
+    unsigned long long suma = 0;
+    for (size_t i = elementy - liczbaWierszy; i < elementy; ++i) {
+        suma = suma * 31 + dane[i].wartosc;
+    }
+    delete[] dane;
+
+    double s = chrono::duration<double>(koniec - start).count();
+    if (liczbaWatkow == 0) {
+        printf("sekwencyjnie   N = %-6d %8.3f s                    suma kontrolna: %016llx\n", liczbaWierszy, s, suma);
+    } else {
+        printf("front fali     N = %-6d %8.3f s  wątki: %-3d x%-5.2f suma kontrolna: %016llx\n",
+               liczbaWierszy, s, liczbaWatkow, odniesienie / s, suma);
+    }
+    return s;
+}
+
+// "--przyblizenie" i "--tablica" uruchamiają tylko jedno sprawdzenie (testy ctest).
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--przyblizenie") == 0) {
+        return sprawdzPrzyblizenie(2000) ? 0 : 1;
+    }
+    if (argc > 1 && strcmp(argv[1], "--tablica") == 0) {
+        return sprawdzTablice() ? 0 : 1;
+    }
+
+    const int wartosciN[] = {10, 1000, 100000};
+
+    for (int n : wartosciN) {
+        zmierz<WierszTrojkataPascala<>>("iteracyjnie", n);
+        if (n <= 67) {
+            zmierz<WierszTrojkataPascala<uint64_t>>("u64", n);
+        }
+        // Rekurencja trzyma naraz wszystkie wiersze 0..n (~n²/2 elementów) i n ramek stosu,
+        // dla n = 100000 to ~20 GB pamięci, więc ten przypadek pomijamy.
+        if (n <= 10000) {
+            zmierz<WierszRekurencyjny>("rekurencyjnie", n);
+        } else {
+            printf("%-14s n = %-7d pominięto (n ramek stosu, ~n²/2 elementów w pamięci)\n", "rekurencyjnie", n);
+        }
+    }
+    bool tablicaBezAlokacji = sprawdzTablice();
+
+    const int nJadra = 30000;
+    const PoziomISA wykryty = JadroWiersza::wykryjPoziom();
+    LiczbaModulo::ustawModul(1000000007);
+    printf("\n");
+    for (PoziomISA poziom : {PoziomISA::ogolny, PoziomISA::sse4, PoziomISA::avx2}) {
+        if (poziom > wykryty) {
+            printf("%-14s pominięto (procesor nie obsługuje)\n", JadroWiersza::nazwa(poziom));
+            continue;
+        }
+        zmierzJadro<int>("int", poziom, nJadra);
+        zmierzJadro<uint64_t>("u64", poziom, nJadra);
+        zmierzJadro<LiczbaModulo>("mod", poziom, nJadra);
+    }
+    JadroWiersza::ustawPoziom(wykryty);
+
+    printf("\n");
+    LiczbaModulo::ustawModul(2);
+    zmierzModulo2<LiczbaModulo>("mod:2 (u32)", nJadra);
+    zmierzModulo2<bool>("mod:2 (bity)", nJadra);
+    zmierzModulo2<bool>("mod:2 (bity)", (1 << 24) - 1);
+    LiczbaModulo::ustawModul(1000000007);
+
+    printf("\n");
+    zmierzNTT(998244353, 100000, true);
+    zmierzNTT(65537, 100000, true);
+    zmierzNTT(998244353, 1000000, false);
+    zmierzNTT(65537, 1000000, false);
+    LiczbaModulo::ustawModul(1000000007);
+
+    printf("\n");
+    bool przyblizenieDokladne = sprawdzPrzyblizenie(2000);
+    zmierzPrzyblizenie();
+
+    printf("\n");
+    LiczbaModulo::ustawModul(998244353);
+    zmierzWypisywanie<LiczbaModulo>("mod", 1000000);
+    LiczbaModulo::ustawModul(1000000007);
+    zmierzWypisywanie<unsigned __int128>("u128", 130);
+    zmierzWypisywanie<DuzaLiczba>("big", 5000);
+
+    printf("\n");
+    zmierzPule(20000, 2000);
+
+    // Przyspieszenie liczone względem ścieżki sekwencyjnej; ~800 MB dla N = 20000.
+    const int nTrojkata = 20000;
+    printf("\n");
+    double sekwencyjnie = zmierzTrojkat(nTrojkata, 0, 0);
+    // Potęgi dwójki i zawsze sama liczba rdzeni, także gdy nie jest potęgą dwójki (np. 6 albo 12).
+    int maksWatkow = max(1u, thread::hardware_concurrency());
+    for (int watki = 1; watki < maksWatkow; watki *= 2) {
+        zmierzTrojkat(nTrojkata, watki, sekwencyjnie);
+    }
+    zmierzTrojkat(nTrojkata, maksWatkow, sekwencyjnie);
+
+    return tablicaBezAlokacji && przyblizenieDokladne ? 0 : 1;
+}
@@ -1,42 +1,474 @@
 #include <iostream>
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <type_traits>
 #include "WierszTrojkataPascala.h"
+#include "LiczbaModulo.h"
+#include "DuzaLiczba.h"
+#include "WierszModulo2.h"
+#include "WierszPromowany.h"
+#include "FormatBinarny.h"
+#include "WyjscieBuforowane.h"
+#include "Serwer.h"
+#include "PrzetwarzanieWsadowe.h"
+#include "TrojkatWPliku.h"
+#include "GeneratorWiersza.h"
+#include "GeneratorKolumny.h"
+#include "KrokSymbolu.h"
+#include "PulaWatkow.h"
 
 using namespace std;
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        printf("Error! Nie podałeś argumentów.");
+// C(n, m) z ln C jako mantysa i wykładnik dziesiętny, bo dla dużych n wynik nie mieści się w double.
+string napisPrzyblizony(long long n, long long m) {
+    double ln = WierszTrojkataPascala<>::logSymbolNewtona(n, m);
+    double log10 = ln / log(10.0);
+    double wykladnik = floor(log10);
+    double mantysa = pow(10.0, log10 - wykladnik);
+    // Zaokrąglenie do 6 miejsc mogłoby dać mantysę 10.000000.
+    if (mantysa >= 9.9999995) {
+        mantysa /= 10;
+        wykladnik += 1;
+    }
+    char bufor[96];
+    snprintf(bufor, sizeof(bufor), "%.6fe+%.0f (ln %.12g)", mantysa, wykladnik, ln);
+    return bufor;
+}
+
+// Elementy bez budowania wiersza: element(n, m) daje napis C(n, m) - wzorem multiplikatywnym
+// w wybranym typie, z rozkładu na czynniki pierwsze albo przybliżony wzorem Stirlinga.
+template <typename Element>
+int tylkoElementy(int argc, char* argv[], int pierwszy, Element element) {
+    if (argc <= pierwszy) {
+        printf("Error! Nie podałeś numeru wiersza.");
         return 1;
     }
 
+    long long n;
     try {
-        int n = stoi(argv[1]);
-        WierszTrojkataPascala wiersz(n);
+        n = stoll(argv[pierwszy]);
+    } catch (const exception& e) {
+        printf("%s - nieprawidłowa dana\n", argv[pierwszy]);
+        return 1;
+    }
 
-        cout << "Wiersz " << n << ": ";
-        for (int i = 0; i <= n; ++i) {
-            cout << wiersz.tablica[i] << " ";
+    for (int i = pierwszy + 1; i < argc; ++i) {
+        long long m;
+        try {
+            m = stoll(argv[i]);
+        } catch (const exception& e) {
+            printf("%s - nieprawidłowa dana\n", argv[i]);
+            continue;
+        }
+        try {
+            string napis = element(n, m);
+            printf("%lld - %s\n", m, napis.c_str());
+        } catch (const exception& e) {
+            printf("%s\n", e.what());
         }
-        cout << endl;
+    }
+
+    return 0;
+}
+
+void zapytanieModulo(const string& n, const string& k, const string& p) {
+    unsigned long long liczbaN, liczbaK, modul;
+    try {
+        liczbaN = stoull(n);
+        liczbaK = stoull(k);
+        modul = stoull(p);
+    } catch (const exception& e) {
+        printf("%s %s %s - nieprawidłowa dana\n", n.c_str(), k.c_str(), p.c_str());
+        return;
+    }
+    try {
+        uint32_t wynik = WierszTrojkataPascala<>::symbolNewtonaModulo(liczbaN, liczbaK, modul);
+        printf("%s %s %s - %u\n", n.c_str(), k.c_str(), p.c_str(), wynik);
+    } catch (const exception& e) {
+        printf("%s %s %s - %s\n", n.c_str(), k.c_str(), p.c_str(), e.what());
+    }
+}
+
+// Trójki "n k p" z argumentów, a gdy ich nie ma - po jednej w wierszu ze standardowego wejścia.
+int zapytaniaModulo(int argc, char* argv[], int pierwszy) {
+    if (argc > pierwszy) {
+        if ((argc - pierwszy) % 3 != 0) {
+            printf("Error! Zapytania podaje się trójkami: n k p.");
+            return 1;
+        }
+        for (int i = pierwszy; i < argc; i += 3) {
+            zapytanieModulo(argv[i], argv[i + 1], argv[i + 2]);
+        }
+        return 0;
+    }
+
+    string n, k, p;
+    while (cin >> n >> k >> p) {
+        zapytanieModulo(n, k, p);
+    }
+    return 0;
+}
+
+// Błąd w wyjściu tekstowym to linia, a w binarnym - ramka błędu.
+void wypiszBlad(bool binarnie, int n, const string& komunikat) {
+    if (binarnie) {
+        FormatBinarny::zapiszBlad(stdout, n, komunikat);
+    } else {
+        printf("%s\n", komunikat.c_str());
+    }
+}
 
-        for (int i = 2; i < argc; ++i) {
-            int m;
+template <typename Wiersz>
+int wypiszWiersz(Wiersz& wiersz, int argc, char* argv[], int pierwszy, int n, bool binarnie = false) {
+    if (binarnie) {
+        FormatBinarny::zapiszWiersz(stdout, wiersz);
+    } else {
+        WyjscieBuforowane wyjscie(stdout);
+        wyjscie.dopisz("Wiersz " + to_string(n) + ": ");
+        wyjscie.dopiszWiersz(wiersz);
+        wyjscie.dopisz('\n');
+    }
+
+    for (int i = pierwszy + 1; i < argc; ++i) {
+        // "a..b" to suma elementów od a do b włącznie.
+        if (const char* kropki = strstr(argv[i], "..")) {
+            int a, b;
             try {
-                m = stoi(argv[i]);
+                a = stoi(string(argv[i], kropki - argv[i]));
+                b = stoi(kropki + 2);
             } catch (const exception& e) {
-                printf("%s - nieprawidłowa dana\n", argv[i]);
+                wypiszBlad(binarnie, n, string(argv[i]) + " - nieprawidłowa dana");
                 continue;
             }
             try {
-                int element = wiersz.MtyElementWiersza(m);
-                printf("%d - %d\n", m, element);
+                if (binarnie) {
+                    FormatBinarny::zapiszSume(stdout, wiersz, a, b);
+                } else {
+                    string suma = wiersz.napisSumy(a, b);
+                    printf("%d..%d - %s\n", a, b, suma.c_str());
+                }
             } catch (const exception& e) {
-                printf("%s\n", e.what());
+                wypiszBlad(binarnie, n, e.what());
+            }
+            continue;
+        }
+
+        int m;
+        try {
+            m = stoi(argv[i]);
+        } catch (const exception& e) {
+            wypiszBlad(binarnie, n, string(argv[i]) + " - nieprawidłowa dana");
+            continue;
+        }
+        try {
+            if (binarnie) {
+                FormatBinarny::zapiszElement(stdout, wiersz, m);
+            } else {
+                string element = wiersz.napisElementu(m);
+                printf("%d - %s\n", m, element.c_str());
+            }
+        } catch (const exception& e) {
+            wypiszBlad(binarnie, n, e.what());
+        }
+    }
+
+    return 0;
+}
+
+// Wiersz wypisywany w trakcie jednego przejścia generatora; żądane elementy m
+// zapamiętujemy po drodze i wypisujemy po wierszu, tak jak w wypiszWiersz.
+template <typename T>
+int wypiszWierszStrumieniowo(int argc, char* argv[], int pierwszy, long long n) {
+    map<long long, string> elementy;
+    for (int i = pierwszy + 1; i < argc; ++i) {
+        try {
+            elementy[stoll(argv[i])];
+        } catch (const exception& e) {
+        }
+    }
+
+    GeneratorWiersza<T> generator(n);
+    {
+        WyjscieBuforowane wyjscie(stdout);
+        wyjscie.dopisz("Wiersz " + to_string(n) + ": ");
+        long long k = 0;
+        try {
+            for (const T& element : generator) {
+                auto zadany = elementy.find(k);
+                if (zadany != elementy.end()) {
+                    zadany->second = naNapis(element);
+                }
+                wyjscie.dopiszLiczbe(element);
+                wyjscie.dopisz(' ');
+                ++k;
+            }
+        } catch (const exception& e) {
+            wyjscie.dopisz(e.what());
+        }
+        wyjscie.dopisz('\n');
+    }
+
+    for (int i = pierwszy + 1; i < argc; ++i) {
+        long long m;
+        try {
+            m = stoll(argv[i]);
+        } catch (const exception& e) {
+            printf("%s - nieprawidłowa dana\n", argv[i]);
+            continue;
+        }
+        if (m < 0 || m > n) {
+            printf("%lld - liczba spoza zakresu\n", m);
+        } else if (elementy[m].empty()) {
+            printf("%lld - wynik przekracza zakres typu\n", m);
+        } else {
+            printf("%lld - %s\n", m, elementy[m].c_str());
+        }
+    }
+
+    return 0;
+}
+
+// Kolumna k dla wierszy k..K, wypisywana w trakcie przejścia generatora.
+template <typename T>
+int wypiszKolumne(long long k, long long K) {
+    GeneratorKolumny<T> generator(k, K);
+    WyjscieBuforowane wyjscie(stdout);
+    wyjscie.dopisz("Kolumna " + to_string(k) + ": ");
+    try {
+        for (const T& element : generator) {
+            wyjscie.dopiszLiczbe(element);
+            wyjscie.dopisz(' ');
+        }
+    } catch (const exception& e) {
+        wyjscie.dopisz(e.what());
+    }
+    wyjscie.dopisz('\n');
+    return 0;
+}
+
+// Wywołuje dzialanie(type_identity<T>{}) dla typu elementu wybranego przez --typ.
+// Dla "auto" bierze najtańszy typ, w którym wiersz n jest jeszcze dokładny.
+template <typename Dzialanie>
+int zTypemElementu(const string& typ, int n, Dzialanie dzialanie) {
+    if (typ == "int") {
+        return dzialanie(type_identity<int>{});
+    } else if (typ == "u64") {
+        return dzialanie(type_identity<uint64_t>{});
+    } else if (typ == "u128") {
+        return dzialanie(type_identity<unsigned __int128>{});
+    } else if (typ == "big") {
+        return dzialanie(type_identity<DuzaLiczba>{});
+    } else if (typ == "auto") {
+        if (n <= WierszTrojkataPascala<int>::najwiekszyDokladnyWiersz()) {
+            return dzialanie(type_identity<int>{});
+        }
+        if (n <= WierszTrojkataPascala<uint64_t>::najwiekszyDokladnyWiersz()) {
+            return dzialanie(type_identity<uint64_t>{});
+        }
+        if (n <= WierszTrojkataPascala<unsigned __int128>::najwiekszyDokladnyWiersz()) {
+            return dzialanie(type_identity<unsigned __int128>{});
+        }
+        return dzialanie(type_identity<DuzaLiczba>{});
+    } else if (typ.rfind("mod:", 0) == 0) {
+        LiczbaModulo::ustawModul(stoull(typ.substr(4)));
+        return dzialanie(type_identity<LiczbaModulo>{});
+    }
+    printf("%s - nieznany typ elementu\n", typ.c_str());
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Error! Nie podałeś argumentów.");
+        return 1;
+    }
+
+    string typ;
+    string format = "text";
+    size_t limitPamieci = (size_t) 256 << 20;
+    int liczbaWatkow = PulaWatkow::domyslnaLiczbaWatkow();
+    string tryb;
+    int pierwszy = 1;
+
+    try {
+        for (; pierwszy < argc && strncmp(argv[pierwszy], "--", 2) == 0; ++pierwszy) {
+            if (strncmp(argv[pierwszy], "--typ=", 6) == 0) {
+                typ = argv[pierwszy] + 6;
+            } else if (strncmp(argv[pierwszy], "--pamiec=", 9) == 0) {
+                limitPamieci = stoull(argv[pierwszy] + 9) << 20;
+            } else if (strncmp(argv[pierwszy], "--watki=", 8) == 0) {
+                liczbaWatkow = stoi(argv[pierwszy] + 8);
+            } else if (strncmp(argv[pierwszy], "--format=", 9) == 0) {
+                format = argv[pierwszy] + 9;
+            } else {
+                tryb = argv[pierwszy];
+            }
+        }
+        // Bez --typ= tryby jednego wiersza, kolumny i trójkąta biorą "auto" (typ dokładny dla największego n,
+        // a pojedynczy wiersz jest promowany), a serwer i tryb wsadowy liczą na int i zgłaszają przepełnienie.
+        bool domyslnyTyp = typ.empty();
+        if (domyslnyTyp) {
+            bool serwerLubWsad = tryb == "--serwer" || tryb == "--wsadowo";
+            typ = serwerLubWsad ? "int" : "auto";
+        }
+
+        if (tryb == "--elementy") {
+            // Bez --typ= zostaje wzór w 128 bitach; "auto" wybiera typ dokładny dla całego wiersza n.
+            if (typ == "przyblizony") {
+                return tylkoElementy(argc, argv, pierwszy, napisPrzyblizony);
+            }
+            if (domyslnyTyp) {
+                return tylkoElementy(argc, argv, pierwszy, [](long long n, long long m) {
+                    return naNapis(WierszTrojkataPascala<>::symbolNewtona(n, m));
+                });
+            }
+            long long n = argc > pierwszy ? strtoll(argv[pierwszy], nullptr, 10) : 0;
+            return zTypemElementu(typ, (int) clamp(n, 0LL, (long long) INT_MAX), [&](auto typElementu) {
+                using T = typename decltype(typElementu)::type;
+                return tylkoElementy(argc, argv, pierwszy, [](long long n, long long m) {
+                    return naNapis(symbolNewtonaWTypie<T>(n, m));
+                });
+            });
+        }
+
+        if (tryb == "--dokladnie") {
+            return tylkoElementy(argc, argv, pierwszy, [&](long long n, long long m) {
+                return WierszTrojkataPascala<>::symbolNewtonaDokladnie(n, m, max(liczbaWatkow, 1)).naNapis();
+            });
+        }
+
+        if (tryb == "--modulo") {
+            return zapytaniaModulo(argc, argv, pierwszy);
+        }
+
+        if (tryb == "--serwer") {
+            // W trybie "auto" typ zależy od n, a serwer obsługuje różne n - bierzemy typ dokładny zawsze.
+            return zTypemElementu(typ == "auto" ? "big" : typ, 0, [&](auto typElementu) {
+                Serwer<typename decltype(typElementu)::type> serwer(limitPamieci);
+                if (argc > pierwszy) {
+                    serwer.nasluchuj(argv[pierwszy]);
+                } else {
+                    serwer.obsluz(stdin, stdout);
+                }
+                return 0;
+            });
+        }
+
+        if (tryb == "--wsadowo") {
+            FILE* wejscie = argc > pierwszy ? fopen(argv[pierwszy], "r") : stdin;
+            if (!wejscie) {
+                printf("%s - nie można otworzyć pliku\n", argv[pierwszy]);
+                return 1;
+            }
+            int wynik = zTypemElementu(typ == "auto" ? "big" : typ, 0, [&](auto typElementu) {
+                PrzetwarzanieWsadowe<typename decltype(typElementu)::type>::przetworz(wejscie, stdout);
+                return 0;
+            });
+            if (wejscie != stdin) {
+                fclose(wejscie);
+            }
+            return wynik;
+        }
+
+        if (tryb == "--trojkat") {
+            if (argc < pierwszy + 2) {
+                printf("Error! Podaj liczbę wierszy i plik wyjściowy.");
+                return 1;
+            }
+            int liczbaWierszy = stoi(argv[pierwszy]);
+            // Wszystkie wiersze mają wspólny typ, więc "auto" wybiera typ dokładny dla ostatniego z nich.
+            return zTypemElementu(typ, liczbaWierszy - 1, [&](auto typElementu) {
+                using T = typename decltype(typElementu)::type;
+                if constexpr (is_same_v<T, DuzaLiczba>) {
+                    printf("big - trójkąt w pliku wymaga elementów stałej szerokości\n");
+                    return 1;
+                } else {
+                    uint64_t bajty = TrojkatWPliku<T>::zapisz(argv[pierwszy + 1], liczbaWierszy, liczbaWatkow);
+                    printf("Trójkąt %d wierszy -> %s (%llu B)\n", liczbaWierszy, argv[pierwszy + 1],
+                           (unsigned long long) bajty);
+                    return 0;
+                }
+            });
+        }
+
+        if (tryb == "--strumien") {
+            if (argc <= pierwszy) {
+                printf("Error! Nie podałeś numeru wiersza.");
+                return 1;
             }
+            long long n = stoll(argv[pierwszy]);
+            return zTypemElementu(typ, (int) min(n, (long long) INT_MAX), [&](auto typElementu) {
+                return wypiszWierszStrumieniowo<typename decltype(typElementu)::type>(argc, argv, pierwszy, n);
+            });
         }
 
+        if (tryb == "--kolumna") {
+            if (argc < pierwszy + 2) {
+                printf("Error! Podaj numer kolumny i ostatni wiersz.");
+                return 1;
+            }
+            long long k = stoll(argv[pierwszy]);
+            long long K = stoll(argv[pierwszy + 1]);
+            // Największy element kolumny to C(K, k), więc "auto" wybiera typ dokładny dla wiersza K.
+            return zTypemElementu(typ, (int) min(K, (long long) INT_MAX), [&](auto typElementu) {
+                return wypiszKolumne<typename decltype(typElementu)::type>(k, K);
+            });
+        }
+
+        if (!tryb.empty()) {
+            printf("%s - nieznana opcja\n", tryb.c_str());
+            return 1;
+        }
+
+        if (argc <= pierwszy) {
+            printf("Error! Nie podałeś numeru wiersza.");
+            return 1;
+        }
+
+        // --format=binary dotyczy tylko wiersza; pozostałe tryby zawsze piszą tekst.
+        if (format != "text" && format != "binary") {
+            printf("%s - nieznany format\n", format.c_str());
+            return 1;
+        }
+        bool binarnie = format == "binary";
+
+        int n = stoi(argv[pierwszy]);
+        // Pojedynczy wiersz modulo 2 liczymy na bitach; pozostałe tryby zostają przy LiczbaModulo.
+        if (typ == "mod:2") {
+            WierszTrojkataPascala<bool> wiersz(n);
+            return wypiszWiersz(wiersz, argc, argv, pierwszy, n, binarnie);
+        }
+        if (typ == "auto") {
+            WierszPromowany wiersz(n, Przechowywanie::polowa);
+            return wypiszWiersz(wiersz, argc, argv, pierwszy, n, binarnie);
+        }
+        return zTypemElementu(typ, n, [&](auto typElementu) {
+            using T = typename decltype(typElementu)::type;
+            if constexpr (is_same_v<T, DuzaLiczba>) {
+                WierszTrojkataPascala<T> wiersz(n, Przechowywanie::polowa);
+                return wypiszWiersz(wiersz, argc, argv, pierwszy, n, binarnie);
+            } else {
+                // Typ podany wprost nie jest promowany, ale zamiast zawiniętych wartości zgłaszamy przepełnienie.
+                WierszTrojkataPascala<T> wiersz(n, Przechowywanie::polowa, true);
+                if (wiersz.size - 1 < n) {
+                    wypiszBlad(binarnie, n, to_string(n) + " - wynik przekracza zakres typu (ostatni dokładny wiersz: "
+                                            + to_string(wiersz.size - 1) + ")");
+                    return 1;
+                }
+                return wypiszWiersz(wiersz, argc, argv, pierwszy, n, binarnie);
+            }
+        });
+
     } catch (const exception& e) {
-        printf("%s", e.what());
+        // Odbiorca formatu binarnego czyta tylko ramki, więc błąd spoza wiersza też idzie ramką (n = -1).
+        if (format == "binary") {
+            FormatBinarny::zapiszBlad(stdout, -1, e.what());
+        } else {
+            printf("%s", e.what());
+        }
     }
 
     return 0;